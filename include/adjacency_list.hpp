@@ -2,9 +2,15 @@
 #define ADJACENCY_LIST_HPP
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include "execution_policy.hpp"
 #include "graph_node.hpp"
 #include "graph_edge.hpp"
 
@@ -12,15 +18,88 @@ template <typename T>
 class adjacency_list
 {
 public:
+  adjacency_list() : version(0), expected_degree(0) {}
+
+  /**
+   * Neighbour sets point at the keys of the list that owns them, so
+   *  a copy rebuilds them to point at its own keys. Moving keeps the
+   *  keys where they are.
+   */
+  adjacency_list(const adjacency_list& that)
+    : version(that.version), expected_degree(that.expected_degree)
+  {
+    adj_list.reserve(that.adj_list.size());
+    for (const auto& entry: that.adj_list) {
+      adj_list.emplace(entry.first, edge_set());
+    }
+
+    for (const auto& entry: that.adj_list) {
+      edge_set& list = adj_list.find(entry.first)->second;
+      list.reserve(entry.second.size());
+
+      for (const auto& redge: entry.second) {
+        list.insert(relative_edge(adj_list.find(*redge.other)->first,
+                                  redge.weight));
+      }
+    }
+  }
+
+  adjacency_list(adjacency_list&&) = default;
+
+  adjacency_list& operator=(const adjacency_list& that)
+  {
+    if (this != &that) {
+      unsigned long next = std::max(version, that.version) + 1;
+      *this = adjacency_list(that);
+      version = next;
+    }
+    return *this;
+  }
+
+  adjacency_list& operator=(adjacency_list&&) = default;
+
+  /**
+   * Reserves room for vertex_count vertices and edge_count edges, so
+   *  that bulk construction does not rehash as it grows.
+   */
+  void reserve(size_t vertex_count, size_t edge_count)
+  {
+    adj_list.reserve(vertex_count);
+    if (vertex_count > 0) {
+      expected_degree = (2 * edge_count + vertex_count - 1) / vertex_count;
+    }
+  }
+
   void add_vertex(const graph_node<T>& vertex)
   {
-    const auto& list = adj_list[vertex];
+    emplace_vertex(vertex);
+  }
+
+  /**
+   * Constructs a vertex from args in place, unless a vertex with the
+   *  same label is already present.
+   * @return The vertex stored in the list.
+   */
+  template <typename... Args>
+  const graph_node<T>& emplace_vertex(Args&&... args)
+  {
+    auto result = adj_list.emplace(std::piecewise_construct,
+                                   std::forward_as_tuple(
+                                     std::forward<Args>(args)...),
+                                   std::forward_as_tuple());
+
+    if (result.second) {
+      result.first->second.reserve(expected_degree);
+      ++version;
+    }
+
+    return result.first->first;
   }
 
   bool add_edge(const graph_edge<T>& edge)
   {
     auto pair = edge.get_vertices();
-    return add_edge(pair.first, pair.second, edge.get_wait());
+    return add_edge(*pair.first, *pair.second, edge.get_weight());
   }
 
   bool add_edge(const graph_node<T>& end1,
@@ -38,19 +117,117 @@ public:
     auto& list1 = it1->second;
     auto& list2 = it2->second;
 
-    auto it3 = list1.find(relative_edge(end2));
-    if (it3 == list1.end()) {
-      list1.insert(relative_edge(end2, weight));
-    } else if (it3->weight != weight) {
+    // Neighbours always point at the keys owned by adj_list, so that
+    //  the same vertex is represented by the same address everywhere.
+    bool added = false;
+    auto it3 = list1.insert(relative_edge(it2->first, weight));
+    if (it3.second) {
+      added = true;
+    } else if (it3.first->weight != weight) {
       // FIXME update the weight
     }
 
-    auto it4 = list2.find(relative_edge(end1));
-    if (it4 == list2.end()) {
-      list2.insert(relative_edge(end1, weight));
-    } else if (it4->weight != weight) {
+    auto it4 = list2.insert(relative_edge(it1->first, weight));
+    if (it4.second) {
+      added = true;
+    } else if (it4.first->weight != weight) {
       // FIXME update the weight
     }
+
+    if (added) {
+      ++version;
+    }
+
+    return added;
+  }
+
+  /**
+   * Adds a batch of edges, given as a range of graph_edge<T>.
+   *
+   * The end points are looked up and the resulting arcs sorted by
+   *  vertex and deduplicated first, so that each neighbour set is
+   *  grown once and then merged into in one pass. With a parallel
+   *  policy, the lookups, the sort and the merge all run in
+   *  parallel; every neighbour set is still written by one thread.
+   *  As with add_edge(), edges whose end points are missing are
+   *  skipped and existing weights are kept.
+   *
+   * @return The number of edges that were not already present.
+   */
+  template <typename I>
+  size_t add_edges(I first, I last,
+                   const execution_policy& policy
+                     = execution_policy::sequential())
+  {
+    std::vector<const graph_edge<T>*> batch;
+    for (; first != last; ++first) {
+      batch.push_back(&*first);
+    }
+
+    std::vector<arc> arcs(2 * batch.size());
+    parallel_for(policy, batch.size(),
+        [this, &batch, &arcs](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            auto pair = batch[i]->get_vertices();
+            auto it1 = adj_list.find(*pair.first);
+            auto it2 = adj_list.find(*pair.second);
+
+            if (it1 == adj_list.end() || it2 == adj_list.end()) {
+              arcs[2 * i] = arcs[2 * i + 1] = arc();
+              continue;
+            }
+
+            double weight = batch[i]->get_weight();
+            arcs[2 * i] = arc(&it1->second, &it2->first, weight, i, true);
+            arcs[2 * i + 1] = arc(&it2->second, &it1->first, weight, i,
+                                  it1 == it2);
+          }
+        });
+
+    arcs.erase(std::remove_if(arcs.begin(), arcs.end(),
+                              [](const arc& a) { return a.list == nullptr; }),
+               arcs.end());
+    sort_arcs(arcs, policy);
+    arcs.erase(std::unique(arcs.begin(), arcs.end(),
+                           [](const arc& a, const arc& b) {
+                             return a.list == b.list && a.other == b.other;
+                           }),
+               arcs.end());
+
+    std::vector<size_t> groups;
+    for (size_t i = 0; i < arcs.size(); ++i) {
+      if (i == 0 || arcs[i].list != arcs[i - 1].list) {
+        groups.push_back(i);
+      }
+    }
+    groups.push_back(arcs.size());
+
+    // The neighbour sets are symmetric, so an edge is new exactly
+    //  when its forward arc is.
+    std::atomic<size_t> count(0);
+    parallel_for(policy, groups.size() - 1,
+        [&arcs, &groups, &count](size_t begin, size_t end) {
+          size_t local = 0;
+          for (size_t g = begin; g < end; ++g) {
+            auto *list = arcs[groups[g]].list;
+            list->reserve(list->size() + groups[g + 1] - groups[g]);
+
+            for (size_t i = groups[g]; i < groups[g + 1]; ++i) {
+              if (list->insert(relative_edge(*arcs[i].other,
+                                             arcs[i].weight)).second
+                  && arcs[i].forward) {
+                ++local;
+              }
+            }
+          }
+          count += local;
+        });
+
+    if (count > 0) {
+      ++version;
+    }
+
+    return count.load();
   }
 
   std::unordered_set<graph_edge<T>> get_edges() const
@@ -110,6 +287,16 @@ public:
     }
   }
 
+  /**
+   * @return The number of edges incident on vertex, or 0 if it is
+   *         not in the list.
+   */
+  size_t get_degree(const graph_node<T>& vertex) const
+  {
+    auto it = adj_list.find(vertex);
+    return (it != adj_list.end()) ? it->second.size() : 0;
+  }
+
   std::unordered_set<graph_edge<T>> get_adjacent_edges(const graph_node<T>& vertex) const
   {
     auto it = adj_list.find(vertex);
@@ -127,6 +314,44 @@ public:
     return result;
   }
 
+  /**
+   * @return A counter that changes whenever a vertex or an edge is
+   *         added, so that results derived from the list can tell
+   *         whether they are stale.
+   */
+  unsigned long get_version() const
+  {
+    return version;
+  }
+
+  /**
+   * Calls f(vertex) for every vertex in the list. The vertex
+   *  references stay valid for the lifetime of the list.
+   */
+  template <typename F>
+  void for_each_vertex(F f) const
+  {
+    for (const auto& entry: adj_list) {
+      f(entry.first);
+    }
+  }
+
+  /**
+   * Calls f(neighbour, weight) for every edge incident on vertex,
+   *  without materializing graph_edge objects.
+   */
+  template <typename F>
+  void for_each_adjacent(const graph_node<T>& vertex, F f) const
+  {
+    auto it = adj_list.find(vertex);
+
+    if (it != adj_list.end()) {
+      for (const auto& redge: it->second) {
+        f(*redge.other, redge.weight);
+      }
+    }
+  }
+
 private:
   struct relative_edge {
     const graph_node<T> *other;
@@ -157,8 +382,76 @@ private:
     }
   };
 
-  std::unordered_map<graph_node<T>,
-                    std::unordered_set<relative_edge, re_hasher>> adj_list;
+  typedef std::unordered_set<relative_edge, re_hasher> edge_set;
+
+  /**
+   * One direction of an edge in an add_edges() batch.
+   */
+  struct arc
+  {
+    edge_set *list;
+    const graph_node<T> *other;
+    double weight;
+    size_t edge;
+    bool forward;
+
+    arc() : list(nullptr), other(nullptr), weight(0), edge(0), forward(false)
+    {}
+
+    arc(edge_set *list, const graph_node<T> *other, double weight,
+        size_t edge, bool forward)
+      : list(list), other(other), weight(weight), edge(edge),
+        forward(forward)
+    {}
+
+    bool operator<(const arc& that) const
+    {
+      std::less<const void*> less;
+      if (list != that.list) {
+        return less(list, that.list);
+      }
+      if (other != that.other) {
+        return less(other, that.other);
+      }
+      return edge < that.edge;
+    }
+  };
+
+  std::unordered_map<graph_node<T>, edge_set> adj_list;
+  unsigned long version;
+  size_t expected_degree;
+
+  /**
+   * Sorts chunks of arcs in parallel, then merges them pairwise.
+   */
+  static void sort_arcs(std::vector<arc>& arcs,
+                        const execution_policy& policy)
+  {
+    size_t chunks = policy.is_sequential() ? 1 : policy.get_thread_count();
+    size_t chunk = std::max<size_t>(1024, (arcs.size() + chunks - 1) / chunks);
+
+    parallel_for(policy, (arcs.size() + chunk - 1) / chunk,
+        [&arcs, chunk](size_t begin, size_t end) {
+          for (size_t c = begin; c < end; ++c) {
+            std::sort(arcs.begin() + c * chunk,
+                      arcs.begin() + std::min(arcs.size(), (c + 1) * chunk));
+          }
+        });
+
+    for (size_t width = chunk; width < arcs.size(); width *= 2) {
+      size_t pairs = (arcs.size() + 2 * width - 1) / (2 * width);
+      parallel_for(policy, pairs,
+          [&arcs, width](size_t begin, size_t end) {
+            for (size_t p = begin; p < end; ++p) {
+              size_t low = p * 2 * width;
+              size_t middle = std::min(arcs.size(), low + width);
+              size_t high = std::min(arcs.size(), low + 2 * width);
+              std::inplace_merge(arcs.begin() + low, arcs.begin() + middle,
+                                 arcs.begin() + high);
+            }
+          });
+    }
+  }
 };
 
 #endif /* ADJACENCY_LIST_HPP */
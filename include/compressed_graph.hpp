@@ -0,0 +1,396 @@
+#ifndef COMPRESSED_GRAPH_HPP
+#define COMPRESSED_GRAPH_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "graph_node.hpp"
+#include "graph_snapshot.hpp"
+
+/**
+ * How compressed_graph stores edge weights.
+ */
+enum class weight_encoding
+{
+  unweighted,  // weights are dropped and read back as 1.0
+  quantized,   // 16 bits, evenly spaced between the min and max weight
+  exact        // the full double
+};
+
+/**
+ * A read-only graph whose neighbour lists are sorted, delta encoded
+ *  and stored as variable length integers.
+ *
+ * The neighbour ids take one or two bytes per arc when neighbours
+ *  have nearby ids, e.g. after reverse_cuthill_mckee(). Each weight
+ *  adds nothing when unweighted, two bytes when quantized and eight
+ *  when exact, the default, against twelve bytes per arc for a
+ *  graph_snapshot and a hash set node per arc for an adjacency_list.
+ *
+ * Unlike graph_snapshot, it keeps its own copy of the vertices, so
+ *  the graph it was built from may be destroyed. It provides
+ *  for_each_vertex(f) and for_each_adjacent(vertex, f), so a
+ *  graph_snapshot can be made from it to run the algorithms on.
+ */
+template <typename T>
+class compressed_graph
+{
+public:
+  struct neighbour
+  {
+    vertex_id id;
+    double weight;
+  };
+
+  /**
+   * Decodes one neighbour list, in increasing order of id.
+   */
+  class neighbour_iterator
+  {
+  public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef neighbour value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const neighbour* pointer;
+    typedef const neighbour& reference;
+
+    neighbour_iterator(const compressed_graph *graph,
+                       const std::uint8_t *position,
+                       const std::uint8_t *end,
+                       vertex_id source)
+      : graph(graph), position(position), end(end), source(source),
+        first(true)
+    {
+      decode();
+    }
+
+    reference operator*() const
+    { return current; }
+
+    pointer operator->() const
+    { return &current; }
+
+    neighbour_iterator& operator++()
+    {
+      decode();
+      return *this;
+    }
+
+    bool operator==(const neighbour_iterator& that) const
+    {
+      return next == that.next;
+    }
+
+    bool operator!=(const neighbour_iterator& that) const
+    {
+      return next != that.next;
+    }
+
+  private:
+    const compressed_graph *graph;
+    const std::uint8_t *position, *end, *next;
+    vertex_id source;
+    bool first;
+    neighbour current;
+
+    // next marks where the current element starts, so that the
+    //  iterator at the last element differs from end()
+    void decode()
+    {
+      next = position;
+      if (position == end) {
+        return;
+      }
+
+      std::uint64_t gap = read_varint(position);
+      if (first) {
+        std::int64_t delta = static_cast<std::int64_t>(gap >> 1)
+                             ^ -static_cast<std::int64_t>(gap & 1);
+        current.id = static_cast<vertex_id>(source + delta);
+        first = false;
+      } else {
+        current.id = static_cast<vertex_id>(current.id + gap + 1);
+      }
+
+      current.weight = graph->read_weight(position);
+    }
+  };
+
+  struct neighbour_range
+  {
+    neighbour_iterator first, last;
+
+    neighbour_iterator begin() const
+    { return first; }
+
+    neighbour_iterator end() const
+    { return last; }
+  };
+
+  explicit compressed_graph(const graph_snapshot<T>& graph,
+                            weight_encoding encoding
+                              = weight_encoding::exact)
+    : encoding(encoding), min_weight(0), weight_step(0)
+  {
+    size_t n = graph.get_vertex_count();
+
+    // ids points into vertices, which must not reallocate
+    vertices.reserve(n);
+    for (vertex_id v = 0; v < n; ++v) {
+      vertices.push_back(graph.get_vertex(v));
+      ids.emplace(&vertices.back(), v);
+    }
+
+    encode([&graph](vertex_id v, auto f) {
+             auto neighbours = graph.get_neighbours(v);
+             const double *weight = graph.get_weights(v).first;
+             for (auto it = neighbours.first; it != neighbours.second;
+                  ++it, ++weight) {
+               f(*it, *weight);
+             }
+           });
+  }
+
+  /**
+   * Encodes any graph that provides for_each_vertex(f) and
+   *  for_each_adjacent(vertex, f), such as adjacency_list<T> or a
+   *  view, straight from its neighbour sets: only one neighbour list
+   *  is held uncompressed at a time.
+   */
+  template <typename G>
+  explicit compressed_graph(const G& graph,
+                            weight_encoding encoding
+                              = weight_encoding::exact)
+    : encoding(encoding), min_weight(0), weight_step(0)
+  {
+    size_t n = 0;
+    graph.for_each_vertex([&n](const graph_node<T>&) { ++n; });
+
+    vertices.reserve(n);
+    graph.for_each_vertex([this](const graph_node<T>& vertex) {
+                            vertices.push_back(vertex);
+                            ids.emplace(&vertices.back(),
+                                        vertices.size() - 1);
+                          });
+
+    encode([this, &graph](vertex_id v, auto f) {
+             graph.for_each_adjacent(vertices[v],
+                 [this, &f](const graph_node<T>& other, double weight) {
+                   f(ids.at(&other), weight);
+                 });
+           });
+  }
+
+  compressed_graph(const compressed_graph&) = delete;
+  compressed_graph& operator=(const compressed_graph&) = delete;
+  compressed_graph(compressed_graph&&) = default;
+  compressed_graph& operator=(compressed_graph&&) = default;
+
+  size_t get_vertex_count() const
+  {
+    return vertices.size();
+  }
+
+  const graph_node<T>& get_vertex(vertex_id id) const
+  {
+    return vertices[id];
+  }
+
+  /**
+   * @return The dense id of vertex, or get_vertex_count() if the
+   *         vertex is not part of the graph.
+   */
+  vertex_id get_id(const graph_node<T>& vertex) const
+  {
+    auto it = ids.find(&vertex);
+    return (it != ids.end()) ? it->second
+                             : static_cast<vertex_id>(vertices.size());
+  }
+
+  size_t get_degree(vertex_id id) const
+  {
+    return degrees[id];
+  }
+
+  neighbour_range get_neighbours(vertex_id id) const
+  {
+    const std::uint8_t *begin = bytes.data() + offsets[id];
+    const std::uint8_t *end = bytes.data() + offsets[id + 1];
+
+    return neighbour_range{ neighbour_iterator(this, begin, end, id),
+                            neighbour_iterator(this, end, end, id) };
+  }
+
+  template <typename F>
+  void for_each_vertex(F f) const
+  {
+    for (const auto& vertex: vertices) {
+      f(vertex);
+    }
+  }
+
+  /**
+   * Calls f(neighbour, weight) for every arc out of vertex, decoding
+   *  the neighbour list as it goes.
+   */
+  template <typename F>
+  void for_each_adjacent(const graph_node<T>& vertex, F f) const
+  {
+    vertex_id id = get_id(vertex);
+
+    if (id != vertices.size()) {
+      for (const auto& n: get_neighbours(id)) {
+        f(vertices[n.id], n.weight);
+      }
+    }
+  }
+
+  /**
+   * @return The size of the encoded neighbour lists, in bytes.
+   */
+  size_t get_encoded_size() const
+  {
+    return bytes.size();
+  }
+
+private:
+  std::vector<graph_node<T>> vertices;
+  std::vector<vertex_id> degrees;
+  std::vector<size_t> offsets;
+  std::vector<std::uint8_t> bytes;
+  std::unordered_map<const graph_node<T>*, vertex_id,
+                     graph_node_ptr_hash<T>,
+                     graph_node_ptr_equal<T>> ids;
+  weight_encoding encoding;
+  double min_weight, weight_step;
+
+  /**
+   * Encodes the neighbour lists of all vertices, in id order.
+   *  for_each_arc(v, f) must call f(id, weight) for every arc out
+   *  of vertex v.
+   */
+  template <typename A>
+  void encode(A for_each_arc)
+  {
+    size_t n = vertices.size();
+
+    if (encoding == weight_encoding::quantized) {
+      double low = std::numeric_limits<double>::max();
+      double high = std::numeric_limits<double>::lowest();
+      for (vertex_id v = 0; v < n; ++v) {
+        for_each_arc(v, [&low, &high](vertex_id, double weight) {
+                          low = std::min(low, weight);
+                          high = std::max(high, weight);
+                        });
+      }
+      if (low <= high) {
+        min_weight = low;
+        weight_step = (high - low) / 65535.0;
+      }
+    }
+
+    degrees.reserve(n);
+    offsets.reserve(n + 1);
+    offsets.push_back(0);
+
+    std::vector<std::pair<vertex_id, double>> arcs;
+    for (vertex_id v = 0; v < n; ++v) {
+      arcs.clear();
+      for_each_arc(v, [&arcs](vertex_id id, double weight) {
+                        arcs.emplace_back(id, weight);
+                      });
+      std::sort(arcs.begin(), arcs.end());
+
+      for (size_t i = 0; i < arcs.size(); ++i) {
+        if (i == 0) {
+          std::int64_t delta = static_cast<std::int64_t>(arcs[i].first)
+                               - static_cast<std::int64_t>(v);
+          write_varint((static_cast<std::uint64_t>(delta) << 1)
+                       ^ static_cast<std::uint64_t>(delta >> 63));
+        } else {
+          write_varint(arcs[i].first - arcs[i - 1].first - 1);
+        }
+        write_weight(arcs[i].second);
+      }
+
+      degrees.push_back(static_cast<vertex_id>(arcs.size()));
+      offsets.push_back(bytes.size());
+    }
+
+    bytes.shrink_to_fit();
+  }
+
+  void write_varint(std::uint64_t value)
+  {
+    while (value >= 0x80) {
+      bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    bytes.push_back(static_cast<std::uint8_t>(value));
+  }
+
+  static std::uint64_t read_varint(const std::uint8_t *& position)
+  {
+    std::uint64_t value = *position & 0x7f;
+    unsigned shift = 7;
+
+    while (*position++ & 0x80) {
+      value |= static_cast<std::uint64_t>(*position & 0x7f) << shift;
+      shift += 7;
+    }
+
+    return value;
+  }
+
+  void write_weight(double weight)
+  {
+    switch (encoding) {
+    case weight_encoding::unweighted:
+      break;
+    case weight_encoding::quantized: {
+      std::uint16_t level = 0;
+      if (weight_step > 0) {
+        level = static_cast<std::uint16_t>(
+                  (weight - min_weight) / weight_step + 0.5);
+      }
+      bytes.push_back(static_cast<std::uint8_t>(level));
+      bytes.push_back(static_cast<std::uint8_t>(level >> 8));
+      break;
+    }
+    case weight_encoding::exact: {
+      std::uint8_t raw[sizeof(double)];
+      std::memcpy(raw, &weight, sizeof(double));
+      bytes.insert(bytes.end(), raw, raw + sizeof(double));
+      break;
+    }
+    }
+  }
+
+  double read_weight(const std::uint8_t *& position) const
+  {
+    switch (encoding) {
+    case weight_encoding::quantized: {
+      std::uint16_t level = static_cast<std::uint16_t>(
+                              position[0] | (position[1] << 8));
+      position += 2;
+      return min_weight + level * weight_step;
+    }
+    case weight_encoding::exact: {
+      double weight;
+      std::memcpy(&weight, position, sizeof(double));
+      position += sizeof(double);
+      return weight;
+    }
+    default:
+      return 1.0;
+    }
+  }
+};
+
+#endif /* COMPRESSED_GRAPH_HPP */
@@ -0,0 +1,448 @@
+#ifndef CONCURRENT_GRAPH_HPP
+#define CONCURRENT_GRAPH_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "adjacency_list.hpp"
+#include "graph_node.hpp"
+#include "graph_snapshot.hpp"
+
+/**
+ * A batch of insertions for concurrent_adjacency_list::apply().
+ */
+template <typename T>
+class graph_update_batch
+{
+public:
+  void add_vertex(const graph_node<T>& vertex)
+  {
+    vertices.push_back(vertex);
+  }
+
+  void add_edge(const T& end1, const T& end2, double weight = 1.0)
+  {
+    edges.emplace_back(end1, end2, weight);
+  }
+
+  bool empty() const
+  {
+    return vertices.empty() && edges.empty();
+  }
+
+private:
+  template <typename> friend class concurrent_adjacency_list;
+
+  std::vector<graph_node<T>> vertices;
+  std::vector<std::tuple<T, T, double>> edges;
+};
+
+namespace detail
+{
+  /**
+   * An insert-only hash index from vertices to dense ids, which one
+   *  writer grows while any number of readers look up.
+   *
+   * An entry is published by storing its vertex pointer last, so a
+   *  reader sees either nothing or the whole entry. Readers pass the
+   *  vertex count of their version and ignore any newer entries.
+   */
+  template <typename T>
+  class vertex_index
+  {
+  public:
+    explicit vertex_index(size_t capacity)
+      : mask(capacity - 1), size(0), slots(new slot[capacity])
+    {}
+
+    /**
+     * Copies the entries of that into a table of capacity slots.
+     */
+    vertex_index(const vertex_index& that, size_t capacity)
+      : vertex_index(capacity)
+    {
+      for (size_t i = 0; i <= that.mask; ++i) {
+        const graph_node<T> *vertex = that.slots[i].vertex.load();
+        if (vertex != nullptr) {
+          insert(vertex, that.slots[i].id);
+        }
+      }
+    }
+
+    size_t get_capacity() const
+    {
+      return mask + 1;
+    }
+
+    /**
+     * @return Whether one more entry would fill more than half of
+     *         the table.
+     */
+    bool is_full() const
+    {
+      return 2 * (size + 1) > mask + 1;
+    }
+
+    void insert(const graph_node<T> *vertex, vertex_id id)
+    {
+      size_t i = position(*vertex);
+      while (slots[i].vertex.load(std::memory_order_relaxed) != nullptr) {
+        i = (i + 1) & mask;
+      }
+
+      slots[i].id = id;
+      slots[i].vertex.store(vertex, std::memory_order_release);
+      ++size;
+    }
+
+    /**
+     * @return The id of vertex, or count if it has none below count.
+     */
+    vertex_id find(const graph_node<T>& vertex, size_t count) const
+    {
+      for (size_t i = position(vertex); ; i = (i + 1) & mask) {
+        const graph_node<T> *other
+          = slots[i].vertex.load(std::memory_order_acquire);
+
+        if (other == nullptr) {
+          break;
+        }
+        if (other == &vertex || *other == vertex) {
+          if (slots[i].id < count) {
+            return slots[i].id;
+          }
+          break;
+        }
+      }
+
+      return static_cast<vertex_id>(count);
+    }
+
+  private:
+    struct slot
+    {
+      std::atomic<const graph_node<T>*> vertex;
+      vertex_id id;
+
+      slot() : vertex(nullptr), id(0) {}
+    };
+
+    size_t mask, size;
+    std::unique_ptr<slot[]> slots;
+
+    size_t position(const graph_node<T>& vertex) const
+    {
+      std::uint64_t h = std::hash<graph_node<T>>()(vertex);
+      h *= 0x9e3779b97f4a7c15ULL;
+      return static_cast<size_t>(h ^ (h >> 32)) & mask;
+    }
+  };
+}
+
+/**
+ * One published version of a concurrent_adjacency_list.
+ *
+ * It answers the same per-vertex queries as graph_snapshot, and
+ *  provides for_each_vertex(f) and for_each_adjacent(vertex, f), so
+ *  a graph_snapshot can be made from it to run the whole-graph
+ *  algorithms. Vertices get dense ids in the order they were added.
+ *
+ * The neighbours of each vertex are kept in a block of their own,
+ *  and the blocks in groups of block_size, all immutable once
+ *  published. A new version copies only the groups and blocks that
+ *  a batch touches, and shares the rest with the version before.
+ */
+template <typename T>
+class graph_version
+{
+public:
+  static const size_t block_size = 64;
+
+  unsigned long get_version() const
+  {
+    return version;
+  }
+
+  size_t get_vertex_count() const
+  {
+    return vertex_count;
+  }
+
+  size_t get_arc_count() const
+  {
+    return arc_count;
+  }
+
+  const graph_node<T>& get_vertex(vertex_id id) const
+  {
+    return *groups[id / block_size]->vertices[id % block_size];
+  }
+
+  /**
+   * @return The dense id of vertex, or get_vertex_count() if the
+   *         vertex is not part of this version.
+   */
+  vertex_id get_id(const graph_node<T>& vertex) const
+  {
+    return index->find(vertex, vertex_count);
+  }
+
+  size_t get_degree(vertex_id id) const
+  {
+    const neighbour_block *block = get_block(id);
+    return (block != nullptr) ? block->targets.size() : 0;
+  }
+
+  /**
+   * @return [begin, end) over the neighbour ids of vertex id.
+   */
+  std::pair<const vertex_id*, const vertex_id*>
+    get_neighbours(vertex_id id) const
+  {
+    const neighbour_block *block = get_block(id);
+    if (block == nullptr) {
+      return std::pair<const vertex_id*, const vertex_id*>();
+    }
+
+    return std::make_pair(block->targets.data(),
+                          block->targets.data() + block->targets.size());
+  }
+
+  /**
+   * @return [begin, end) over the edge weights of vertex id, in
+   *         the same order as get_neighbours(id).
+   */
+  std::pair<const double*, const double*>
+    get_weights(vertex_id id) const
+  {
+    const neighbour_block *block = get_block(id);
+    if (block == nullptr) {
+      return std::pair<const double*, const double*>();
+    }
+
+    return std::make_pair(block->weights.data(),
+                          block->weights.data() + block->weights.size());
+  }
+
+  template <typename F>
+  void for_each_vertex(F f) const
+  {
+    for (vertex_id id = 0; id < vertex_count; ++id) {
+      f(get_vertex(id));
+    }
+  }
+
+  template <typename F>
+  void for_each_adjacent(const graph_node<T>& vertex, F f) const
+  {
+    vertex_id id = get_id(vertex);
+    if (id == vertex_count) {
+      return;
+    }
+
+    auto neighbours = get_neighbours(id);
+    const double *weight = get_weights(id).first;
+    for (auto it = neighbours.first; it != neighbours.second;
+         ++it, ++weight) {
+      f(get_vertex(*it), *weight);
+    }
+  }
+
+private:
+  template <typename> friend class concurrent_adjacency_list;
+
+  struct neighbour_block
+  {
+    std::vector<vertex_id> targets;
+    std::vector<double> weights;
+  };
+
+  struct vertex_group
+  {
+    const graph_node<T> *vertices[block_size];
+    std::shared_ptr<neighbour_block> blocks[block_size];
+
+    vertex_group() : vertices() {}
+  };
+
+  unsigned long version;
+  size_t vertex_count, arc_count;
+  std::vector<std::shared_ptr<vertex_group>> groups;
+  std::shared_ptr<detail::vertex_index<T>> index;
+
+  graph_version()
+    : version(0), vertex_count(0), arc_count(0),
+      index(std::make_shared<detail::vertex_index<T>>(16))
+  {}
+
+  const neighbour_block* get_block(vertex_id id) const
+  {
+    return groups[id / block_size]->blocks[id % block_size].get();
+  }
+
+  // The edit_ functions copy a group or block the first time a batch
+  //  touches it; copied records which ones this version owns.
+  vertex_group& edit_group(size_t group, std::unordered_set<size_t>& copied)
+  {
+    if (group == groups.size()) {
+      groups.push_back(std::make_shared<vertex_group>());
+      copied.insert(group);
+    } else if (copied.insert(group).second) {
+      groups[group] = std::make_shared<vertex_group>(*groups[group]);
+    }
+
+    return *groups[group];
+  }
+
+  neighbour_block& edit_block(vertex_id id,
+                              std::unordered_set<size_t>& copied_groups,
+                              std::unordered_set<vertex_id>& copied_blocks)
+  {
+    std::shared_ptr<neighbour_block>& block
+      = edit_group(id / block_size, copied_groups).blocks[id % block_size];
+
+    if (copied_blocks.insert(id).second) {
+      block = (block != nullptr) ? std::make_shared<neighbour_block>(*block)
+                                 : std::make_shared<neighbour_block>();
+    }
+
+    return *block;
+  }
+};
+
+template <typename T>
+const size_t graph_version<T>::block_size;
+
+/**
+ * An adjacency list that can be read while it is being written.
+ *
+ * Readers call get_snapshot() and work on an immutable graph_version
+ *  for as long as they hold on to it. A single writer applies a whole
+ *  batch of insertions to a private copy of the changed parts and
+ *  then publishes the new version with one pointer swap
+ *  (read-copy-update), so readers never wait for a batch to be
+ *  applied. The swap itself uses the atomic shared_ptr functions,
+ *  which libstdc++ implements with a short internal lock.
+ *
+ * Applying a batch costs time in the number of vertices divided by
+ *  graph_version::block_size, plus the degrees of the vertices it
+ *  touches, rather than the size of the whole graph. Versions refer
+ *  to the vertices stored in the list, which must outlive them.
+ */
+template <typename T>
+class concurrent_adjacency_list
+{
+public:
+  concurrent_adjacency_list()
+    : published(new graph_version<T>())
+  {}
+
+  concurrent_adjacency_list(const concurrent_adjacency_list&) = delete;
+  concurrent_adjacency_list& operator=(const concurrent_adjacency_list&)
+    = delete;
+
+  /**
+   * @return The latest published version of the graph.
+   */
+  std::shared_ptr<const graph_version<T>> get_snapshot() const
+  {
+    return std::atomic_load(&published);
+  }
+
+  /**
+   * @return The adjacency list version of the latest snapshot.
+   */
+  unsigned long get_version() const
+  {
+    return get_snapshot()->get_version();
+  }
+
+  /**
+   * Applies the insertions of batch, vertices first, and publishes
+   *  the result. Edges whose end points are missing are skipped, as
+   *  in adjacency_list::add_edge().
+   *
+   * @return The version of the published snapshot.
+   */
+  unsigned long apply(const graph_update_batch<T>& batch)
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    std::shared_ptr<const graph_version<T>> current = published;
+
+    if (batch.empty()) {
+      return current->get_version();
+    }
+
+    std::shared_ptr<graph_version<T>> next(new graph_version<T>(*current));
+    std::unordered_set<size_t> copied_groups;
+    std::unordered_set<vertex_id> copied_blocks;
+
+    for (const auto& vertex: batch.vertices) {
+      size_t count = adj_list.get_vertex_count();
+      const graph_node<T>& stored = adj_list.emplace_vertex(vertex);
+      if (adj_list.get_vertex_count() == count) {
+        continue;
+      }
+
+      // Versions already published keep the smaller index.
+      if (next->index->is_full()) {
+        next->index = std::make_shared<detail::vertex_index<T>>(
+                        *next->index, 2 * next->index->get_capacity());
+      }
+
+      vertex_id id = static_cast<vertex_id>(next->vertex_count++);
+      next->index->insert(&stored, id);
+      next->edit_group(id / graph_version<T>::block_size, copied_groups)
+        .vertices[id % graph_version<T>::block_size] = &stored;
+    }
+
+    for (const auto& edge: batch.edges) {
+      const graph_node<T> *end1 = adj_list.find_vertex(std::get<0>(edge));
+      const graph_node<T> *end2 = adj_list.find_vertex(std::get<1>(edge));
+      double weight = std::get<2>(edge);
+
+      if (end1 == nullptr || end2 == nullptr
+          || !adj_list.add_edge(*end1, *end2, weight)) {
+        continue;
+      }
+
+      vertex_id id1 = next->get_id(*end1);
+      vertex_id id2 = next->get_id(*end2);
+
+      auto& block1 = next->edit_block(id1, copied_groups, copied_blocks);
+      block1.targets.push_back(id2);
+      block1.weights.push_back(weight);
+      ++next->arc_count;
+
+      if (id1 != id2) {
+        auto& block2 = next->edit_block(id2, copied_groups, copied_blocks);
+        block2.targets.push_back(id1);
+        block2.weights.push_back(weight);
+        ++next->arc_count;
+      }
+    }
+
+    if (adj_list.get_version() == current->get_version()) {
+      return current->get_version();
+    }
+
+    next->version = adj_list.get_version();
+    std::atomic_store(&published,
+                      std::shared_ptr<const graph_version<T>>(next));
+
+    return next->version;
+  }
+
+private:
+  adjacency_list<T> adj_list;
+  std::shared_ptr<const graph_version<T>> published;
+  std::mutex writer_mutex;
+};
+
+#endif /* CONCURRENT_GRAPH_HPP */
@@ -0,0 +1,220 @@
+#ifndef CONNECTED_COMPONENTS_HPP
+#define CONNECTED_COMPONENTS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "adjacency_list.hpp"
+#include "execution_policy.hpp"
+#include "graph_snapshot.hpp"
+
+/**
+ * Result of a connected components labelling.
+ *
+ * component[v] is the component id of the vertex with dense id v,
+ *  component ids are dense in [0, sizes.size()) and sizes[c] is
+ *  the number of vertices in component c.
+ */
+struct component_labels
+{
+  std::vector<size_t> component;
+  std::vector<size_t> sizes;
+
+  size_t get_component_count() const
+  {
+    return sizes.size();
+  }
+};
+
+namespace detail
+{
+  /**
+   * Hooks the trees of u and v together, always pointing the
+   *  higher root at the lower one so that concurrent links
+   *  cannot form a cycle.
+   */
+  inline void afforest_link(std::vector<std::atomic<vertex_id>>& parent,
+                            vertex_id u, vertex_id v)
+  {
+    vertex_id p1 = parent[u].load(std::memory_order_relaxed);
+    vertex_id p2 = parent[v].load(std::memory_order_relaxed);
+
+    while (p1 != p2) {
+      vertex_id high = std::max(p1, p2);
+      vertex_id low = std::min(p1, p2);
+      vertex_id p_high = parent[high].load(std::memory_order_relaxed);
+
+      if (p_high == low) {
+        break;
+      }
+
+      if (p_high == high
+          && parent[high].compare_exchange_strong(p_high, low)) {
+        break;
+      }
+
+      p1 = parent[parent[high].load(std::memory_order_relaxed)]
+             .load(std::memory_order_relaxed);
+      p2 = parent[low].load(std::memory_order_relaxed);
+    }
+  }
+
+  inline void afforest_compress(std::vector<std::atomic<vertex_id>>& parent,
+                                size_t begin, size_t end)
+  {
+    for (size_t n = begin; n < end; ++n) {
+      vertex_id p = parent[n].load(std::memory_order_relaxed);
+      vertex_id gp = parent[p].load(std::memory_order_relaxed);
+
+      while (p != gp) {
+        parent[n].store(gp, std::memory_order_relaxed);
+        p = gp;
+        gp = parent[p].load(std::memory_order_relaxed);
+      }
+    }
+  }
+}
+
+/**
+ * Labels the connected components of a snapshot using the
+ *  Afforest algorithm (a sampling refinement of Shiloach-Vishkin).
+ *
+ * The first neighbour_rounds neighbours of every vertex are linked
+ *  first. That is usually enough to reveal the giant component,
+ *  whose vertices then skip their remaining neighbours entirely.
+ */
+template <typename T>
+component_labels connected_components(const graph_snapshot<T>& graph,
+                                      const execution_policy& policy
+                                        = execution_policy::parallel(),
+                                      unsigned neighbour_rounds = 2)
+{
+  size_t n = graph.get_vertex_count();
+  std::vector<std::atomic<vertex_id>> parent(n);
+
+  parallel_for(policy, n,
+      [&parent](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+          parent[v].store(static_cast<vertex_id>(v),
+                          std::memory_order_relaxed);
+        }
+      });
+
+  for (unsigned round = 0; round < neighbour_rounds; ++round) {
+    parallel_for(policy, n,
+        [&parent, &graph, round](size_t begin, size_t end) {
+          for (size_t v = begin; v < end; ++v) {
+            auto range = graph.get_neighbours(static_cast<vertex_id>(v));
+            if (range.first + round < range.second) {
+              detail::afforest_link(parent, static_cast<vertex_id>(v),
+                                    range.first[round]);
+            }
+          }
+        });
+
+    parallel_for(policy, n,
+        [&parent](size_t begin, size_t end) {
+          detail::afforest_compress(parent, begin, end);
+        });
+  }
+
+  // Guess the largest intermediate component from a small sample.
+  vertex_id giant = 0;
+  if (n > 0) {
+    std::unordered_map<vertex_id, size_t> counts;
+    std::mt19937 rng(27491095);
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+    size_t most = 0;
+
+    for (size_t i = 0; i < 1024; ++i) {
+      vertex_id root = parent[pick(rng)].load(std::memory_order_relaxed);
+      size_t count = ++counts[root];
+      if (count > most) {
+        most = count;
+        giant = root;
+      }
+    }
+  }
+
+  parallel_for(policy, n,
+      [&parent, &graph, giant, neighbour_rounds](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+          if (parent[v].load(std::memory_order_relaxed) == giant) {
+            continue;
+          }
+
+          auto range = graph.get_neighbours(static_cast<vertex_id>(v));
+          for (auto it = range.first + std::min<size_t>(
+                             neighbour_rounds, range.second - range.first);
+               it != range.second; ++it) {
+            detail::afforest_link(parent, static_cast<vertex_id>(v), *it);
+          }
+        }
+      });
+
+  parallel_for(policy, n,
+      [&parent](size_t begin, size_t end) {
+        detail::afforest_compress(parent, begin, end);
+      });
+
+  // Renumber the roots densely.
+  component_labels result;
+  result.component.resize(n);
+  std::vector<size_t> root_label(n, n);
+
+  for (size_t v = 0; v < n; ++v) {
+    vertex_id root = parent[v].load(std::memory_order_relaxed);
+    if (root_label[root] == n) {
+      root_label[root] = result.sizes.size();
+      result.sizes.push_back(0);
+    }
+    result.component[v] = root_label[root];
+    ++result.sizes[root_label[root]];
+  }
+
+  return result;
+}
+
+/**
+ * Connected components of an adjacency list, by vertex.
+ *
+ * component maps every vertex to its component id; ids are dense
+ *  in [0, sizes.size()) and sizes[c] is the number of vertices in
+ *  component c, as in component_labels.
+ */
+template <typename T>
+struct vertex_component_labels
+{
+  std::unordered_map<graph_node<T>, size_t> component;
+  std::vector<size_t> sizes;
+
+  size_t get_component_count() const
+  {
+    return sizes.size();
+  }
+};
+
+template <typename T>
+vertex_component_labels<T> connected_components(
+                             const adjacency_list<T>& adj_list,
+                             const execution_policy& policy
+                               = execution_policy::parallel())
+{
+  graph_snapshot<T> snapshot(adj_list);
+  component_labels labels = connected_components(snapshot, policy);
+
+  vertex_component_labels<T> result;
+  result.component.reserve(snapshot.get_vertex_count());
+  for (vertex_id v = 0; v < snapshot.get_vertex_count(); ++v) {
+    result.component.emplace(snapshot.get_vertex(v), labels.component[v]);
+  }
+  result.sizes = std::move(labels.sizes);
+
+  return result;
+}
+
+#endif /* CONNECTED_COMPONENTS_HPP */
@@ -0,0 +1,170 @@
+#ifndef EXECUTION_POLICY_HPP
+#define EXECUTION_POLICY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "thread_pool.hpp"
+
+/**
+ * Says how many threads an algorithm may use, and from which pool.
+ *
+ * Copies of a parallel policy share one budget of helper threads,
+ *  so a request that passes its policy down to nested parallel loops
+ *  never has more than get_thread_count() threads running at once,
+ *  counting the calling thread. Loops that find the budget spent run
+ *  inline. A policy made by a separate call to parallel() has a
+ *  budget of its own.
+ */
+class execution_policy
+{
+public:
+  static execution_policy sequential()
+  {
+    return execution_policy(1, nullptr);
+  }
+
+  /**
+   * @param thread_count Upper bound on the threads used, or 0 for
+   *                     the size of the pool.
+   * @param pool         The pool to run on, or null for the default.
+   */
+  static execution_policy parallel(unsigned thread_count = 0,
+                                   thread_pool *pool = nullptr)
+  {
+    return execution_policy(thread_count, pool);
+  }
+
+  unsigned get_thread_count() const
+  {
+    return thread_count;
+  }
+
+  bool is_sequential() const
+  {
+    return thread_count == 1;
+  }
+
+  thread_pool& get_pool() const
+  {
+    return (pool != nullptr) ? *pool : thread_pool::get_default();
+  }
+
+  /**
+   * Takes up to wanted helper threads from the shared budget.
+   * @return The number taken, to be given back with release().
+   */
+  unsigned acquire(unsigned wanted) const
+  {
+    unsigned available = helpers->load();
+
+    while (available > 0) {
+      unsigned taken = std::min(available, wanted);
+      if (helpers->compare_exchange_weak(available, available - taken)) {
+        return taken;
+      }
+    }
+
+    return 0;
+  }
+
+  void release(unsigned count) const
+  {
+    *helpers += count;
+  }
+
+private:
+  unsigned thread_count;
+  thread_pool *pool;
+  std::shared_ptr<std::atomic<unsigned>> helpers;
+
+  execution_policy(unsigned thread_count, thread_pool *pool)
+    : thread_count(thread_count), pool(pool)
+  {
+    if (this->thread_count == 0) {
+      this->thread_count = get_pool().size() + 1;
+    }
+    helpers = std::make_shared<std::atomic<unsigned>>(
+                this->thread_count - 1);
+  }
+};
+
+/**
+ * Calls f(begin, end) over disjoint chunks covering [0, count).
+ *
+ * The calling thread takes part in the loop and, while it waits for
+ *  the helpers, runs other queued tasks instead of blocking. The
+ *  first exception thrown by f is rethrown on the calling thread.
+ */
+template <typename F>
+void parallel_for(const execution_policy& policy, size_t count, F f)
+{
+  if (count == 0) {
+    return;
+  }
+
+  unsigned wanted = static_cast<unsigned>(
+                      std::min<size_t>(policy.get_thread_count(), count)) - 1;
+  unsigned helpers = (wanted > 0) ? policy.acquire(wanted) : 0;
+
+  if (helpers == 0) {
+    f(size_t(0), count);
+    return;
+  }
+
+  // Hand out several small chunks per thread, so that threads that
+  //  finish early pick up the slack.
+  unsigned thread_count = helpers + 1;
+  size_t chunk = std::max<size_t>(1, count / (8 * thread_count));
+  std::atomic<size_t> next(0);
+  std::atomic<unsigned> running(helpers);
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  auto work = [&]() {
+    try {
+      while (true) {
+        size_t begin = next.fetch_add(chunk);
+        if (begin >= count) {
+          break;
+        }
+        f(begin, std::min(count, begin + chunk));
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+      next.store(count);
+    }
+  };
+
+  // Each helper gives its budget back as soon as it is done, so that
+  //  a slot is never counted twice.
+  thread_pool& pool = policy.get_pool();
+  for (unsigned i = 0; i < helpers; ++i) {
+    pool.submit([&work, &running, &policy]() {
+                  work();
+                  policy.release(1);
+                  --running;
+                });
+  }
+
+  work();
+
+  while (running.load() != 0) {
+    if (!pool.try_run_one()) {
+      std::this_thread::yield();
+    }
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+#endif /* EXECUTION_POLICY_HPP */
@@ -0,0 +1,275 @@
+#ifndef EXTERNAL_MST_HPP
+#define EXTERNAL_MST_HPP
+
+#include <algorithm>
+#include <cstdio>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "disjoint_sets.hpp"
+
+/**
+ * One edge as read from, and written to, an edge stream: a line
+ *  "end1 end2 weight", with the labels read by operator>>.
+ */
+template <typename T>
+struct edge_record
+{
+  T end1, end2;
+  double weight;
+};
+
+template <typename T>
+std::istream& operator>>(std::istream& in, edge_record<T>& record)
+{
+  return in >> record.end1 >> record.end2 >> record.weight;
+}
+
+template <typename T>
+std::ostream& operator<<(std::ostream& out, const edge_record<T>& record)
+{
+  return out << record.end1 << ' ' << record.end2 << ' '
+             << record.weight << '\n';
+}
+
+namespace detail
+{
+  /**
+   * A sorted run of edge records in a temporary file, which is
+   *  removed when the run is destroyed. The file is anonymous unless
+   *  a directory is given to create it in.
+   */
+  template <typename T>
+  class edge_run
+  {
+  public:
+    explicit edge_run(const std::string& directory)
+    {
+      if (directory.empty()) {
+        file = std::tmpfile();
+      } else {
+        std::random_device random;
+        std::ostringstream name;
+        name << directory << "/edge-run-" << std::hex << random()
+             << random() << ".tmp";
+        path = name.str();
+        file = std::fopen(path.c_str(), "w+b");
+      }
+
+      if (file == nullptr) {
+        throw std::runtime_error("cannot create a temporary edge run");
+      }
+    }
+
+    ~edge_run()
+    {
+      std::fclose(file);
+      if (!path.empty()) {
+        std::remove(path.c_str());
+      }
+    }
+
+    edge_run(const edge_run&) = delete;
+    edge_run& operator=(const edge_run&) = delete;
+
+    void write(const edge_record<T>& record)
+    {
+      std::ostringstream line;
+      line.precision(17);
+      line << record;
+      const std::string& text = line.str();
+      if (std::fwrite(text.data(), 1, text.size(), file) != text.size()) {
+        throw std::runtime_error("cannot write a temporary edge run");
+      }
+    }
+
+    void rewind()
+    {
+      std::rewind(file);
+    }
+
+    bool read(edge_record<T>& record)
+    {
+      std::string text;
+      int c;
+      while ((c = std::fgetc(file)) != EOF && c != '\n') {
+        text.push_back(static_cast<char>(c));
+      }
+
+      if (text.empty()) {
+        return false;
+      }
+
+      std::istringstream line(text);
+      return static_cast<bool>(line >> record);
+    }
+
+  private:
+    std::FILE *file;
+    std::string path;
+  };
+
+  /**
+   * Merges sorted runs by weight, calling sink(record) for each
+   *  record in order.
+   */
+  template <typename T, typename F>
+  void merge_edge_runs(std::vector<std::unique_ptr<edge_run<T>>>& runs,
+                       F sink)
+  {
+    typedef std::pair<edge_record<T>, size_t> head;
+    auto heavier = [](const head& left, const head& right) {
+      return left.first.weight > right.first.weight;
+    };
+    std::priority_queue<head, std::vector<head>, decltype(heavier)>
+      heads(heavier);
+
+    for (size_t i = 0; i < runs.size(); ++i) {
+      edge_record<T> record;
+      runs[i]->rewind();
+      if (runs[i]->read(record)) {
+        heads.emplace(std::move(record), i);
+      }
+    }
+
+    while (!heads.empty()) {
+      head top = heads.top();
+      heads.pop();
+      sink(top.first);
+
+      edge_record<T> record;
+      if (runs[top.second]->read(record)) {
+        heads.emplace(std::move(record), top.second);
+      }
+    }
+  }
+}
+
+/**
+ * Kruskal's algorithm over an edge stream that need not fit in
+ *  memory.
+ *
+ * The edges are read in runs of run_size records, each sorted by
+ *  weight and spilled to a temporary file; the runs are then merged,
+ *  at most max_fan_in at a time, into a single stream of increasing
+ *  weight. Only the current run and a disjoint_sets over the vertex
+ *  labels are kept in memory. Edges that join two trees are written
+ *  to forest as they are found, in the input format, at full
+ *  precision; the precision of forest is restored afterwards.
+ *
+ * @param spill_directory Where to create the runs, or empty for
+ *                        anonymous files from std::tmpfile().
+ * @return The number of edges written, i.e. the vertex count minus
+ *         the number of trees in the minimum spanning forest.
+ * @throws std::runtime_error If edges holds a malformed record, or
+ *         a run cannot be created or written.
+ */
+template <typename T>
+size_t external_minimum_spanning_forest(std::istream& edges,
+                                        std::ostream& forest,
+                                        size_t run_size = 1 << 20,
+                                        size_t max_fan_in = 64,
+                                        const std::string& spill_directory
+                                          = std::string())
+{
+  typedef std::unique_ptr<detail::edge_run<T>> run_ptr;
+  auto lighter = [](const edge_record<T>& left,
+                    const edge_record<T>& right) {
+    return left.weight < right.weight;
+  };
+
+  run_size = std::max<size_t>(1, run_size);
+  max_fan_in = std::max<size_t>(2, max_fan_in);
+
+  std::vector<run_ptr> runs;
+  std::vector<edge_record<T>> buffer;
+  buffer.reserve(std::min<size_t>(run_size, 1 << 20));
+
+  // Skipping white space first tells the end of the input apart
+  //  from a record that is cut short or cannot be parsed.
+  edge_record<T> record;
+  bool more = true;
+  while (more) {
+    buffer.clear();
+    while (buffer.size() < run_size) {
+      more = !(edges >> std::ws).eof();
+      if (!more) {
+        break;
+      }
+      if (!(edges >> record)) {
+        throw std::runtime_error("malformed edge record");
+      }
+      buffer.push_back(record);
+    }
+
+    if (buffer.empty()) {
+      break;
+    }
+
+    std::sort(buffer.begin(), buffer.end(), lighter);
+    runs.emplace_back(new detail::edge_run<T>(spill_directory));
+    for (const auto& sorted: buffer) {
+      runs.back()->write(sorted);
+    }
+  }
+
+  buffer.clear();
+  buffer.shrink_to_fit();
+
+  while (runs.size() > max_fan_in) {
+    std::vector<run_ptr> merged;
+    for (size_t first = 0; first < runs.size(); first += max_fan_in) {
+      size_t last = std::min(runs.size(), first + max_fan_in);
+      std::vector<run_ptr> group;
+      for (size_t i = first; i < last; ++i) {
+        group.push_back(std::move(runs[i]));
+      }
+
+      merged.emplace_back(new detail::edge_run<T>(spill_directory));
+      detail::edge_run<T>& out = *merged.back();
+      detail::merge_edge_runs(group, [&out](const edge_record<T>& r) {
+                                out.write(r);
+                              });
+    }
+    runs.swap(merged);
+  }
+
+  // The sets hold pointers, so the labels live in a node container.
+  std::unordered_set<T> labels;
+  disjoint_sets<T> vertex_sets;
+  size_t emitted = 0;
+
+  std::streamsize precision = forest.precision(17);
+  try {
+    detail::merge_edge_runs(runs,
+        [&labels, &vertex_sets, &emitted, &forest](const edge_record<T>& r) {
+          const T& end1 = *labels.insert(r.end1).first;
+          const T& end2 = *labels.insert(r.end2).first;
+          vertex_sets.add(end1);
+          vertex_sets.add(end2);
+
+          if (vertex_sets.find(end1) != vertex_sets.find(end2)) {
+            vertex_sets.merge(end1, end2);
+            forest << r;
+            ++emitted;
+          }
+        });
+  } catch (...) {
+    forest.precision(precision);
+    throw;
+  }
+  forest.precision(precision);
+
+  return emitted;
+}
+
+#endif /* EXTERNAL_MST_HPP */
@@ -1,16 +1,18 @@
 #ifndef GRAPH_NODE_HPP
 #define GRAPH_NODE_HPP
 
+#include <utility>
+
 #include "utility/make_hash.hpp"
 
 template <typename T>
 class graph_node
 {
 public:
-  graph_node(T label) : label(label), weight(1.0)
+  graph_node(T label) : label(std::move(label)), weight(1.0)
   {}
 
-  graph_node(T label, double weight) : label(label), weight(weight)
+  graph_node(T label, double weight) : label(std::move(label)), weight(weight)
   {}
 
   const T& get_label() const
@@ -36,6 +38,30 @@ bool operator!=(const graph_node<T>& left,
 }
 
 
+/**
+ * Hash and equality for graph_node pointers that look through the
+ *  pointer at the label, so that distinct nodes with equal labels
+ *  find each other in an unordered container of pointers.
+ */
+template <typename T>
+struct graph_node_ptr_hash
+{
+  std::size_t operator() (const graph_node<T> *element) const
+  {
+    return make_hash(element->get_label());
+  }
+};
+
+template <typename T>
+struct graph_node_ptr_equal
+{
+  bool operator() (const graph_node<T> *left,
+                   const graph_node<T> *right) const
+  {
+    return left == right || *left == *right;
+  }
+};
+
 namespace std {
   template <typename T>
   struct hash<graph_node<T>>
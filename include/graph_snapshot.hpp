@@ -0,0 +1,162 @@
+#ifndef GRAPH_SNAPSHOT_HPP
+#define GRAPH_SNAPSHOT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "graph_node.hpp"
+
+typedef std::uint32_t vertex_id;
+
+/**
+ * An immutable, compressed sparse row (CSR) copy of a graph.
+ *
+ * Every vertex gets a dense id in [0, get_vertex_count()) and
+ *  the neighbours of a vertex are stored contiguously, which is
+ *  what the whole-graph algorithms want to iterate over.
+ *
+ * It is a reference container: the vertices are not copied, so
+ *  the source graph must outlive the snapshot.
+ */
+template <typename T>
+class graph_snapshot
+{
+public:
+  graph_snapshot() : offsets(1, 0) {}
+
+  /**
+   * Builds a snapshot of any graph that provides
+   *  for_each_vertex(f) and for_each_adjacent(vertex, f),
+   *  such as adjacency_list<T>.
+   */
+  template <typename G>
+  explicit graph_snapshot(const G& graph)
+    : offsets(1, 0)
+  {
+    graph.for_each_vertex([this](const graph_node<T>& vertex) {
+                            ids.emplace(&vertex, vertices.size());
+                            vertices.push_back(&vertex);
+                          });
+
+    for (const auto *vertex: vertices) {
+      graph.for_each_adjacent(*vertex,
+                              [this](const graph_node<T>& other,
+                                     double weight) {
+                                targets.push_back(ids.at(&other));
+                                weights.push_back(weight);
+                              });
+      offsets.push_back(targets.size());
+    }
+  }
+
+  size_t get_vertex_count() const
+  {
+    return vertices.size();
+  }
+
+  /**
+   * @return The number of directed arcs, i.e. twice the number
+   *         of undirected edges.
+   */
+  size_t get_arc_count() const
+  {
+    return targets.size();
+  }
+
+  const graph_node<T>& get_vertex(vertex_id id) const
+  {
+    return *vertices[id];
+  }
+
+  /**
+   * @return The dense id of vertex, or get_vertex_count() if the
+   *         vertex is not part of the snapshot.
+   */
+  vertex_id get_id(const graph_node<T>& vertex) const
+  {
+    auto it = ids.find(&vertex);
+    return (it != ids.end()) ? it->second
+                             : static_cast<vertex_id>(vertices.size());
+  }
+
+  size_t get_degree(vertex_id id) const
+  {
+    return offsets[id + 1] - offsets[id];
+  }
+
+  /**
+   * @return [begin, end) over the neighbour ids of vertex id.
+   */
+  std::pair<const vertex_id*, const vertex_id*>
+    get_neighbours(vertex_id id) const
+  {
+    return std::make_pair(targets.data() + offsets[id],
+                          targets.data() + offsets[id + 1]);
+  }
+
+  /**
+   * @return [begin, end) over the edge weights of vertex id, in
+   *         the same order as get_neighbours(id).
+   */
+  std::pair<const double*, const double*>
+    get_weights(vertex_id id) const
+  {
+    return std::make_pair(weights.data() + offsets[id],
+                          weights.data() + offsets[id + 1]);
+  }
+
+  /**
+   * Renumbers the vertices: vertex new_to_old[i] of this snapshot
+   *  becomes vertex i of the result. Neighbour lists are sorted by
+   *  their new ids.
+   */
+  graph_snapshot get_permuted(const std::vector<vertex_id>& new_to_old) const
+  {
+    size_t n = vertices.size();
+    std::vector<vertex_id> old_to_new(n);
+    for (vertex_id i = 0; i < n; ++i) {
+      old_to_new[new_to_old[i]] = i;
+    }
+
+    graph_snapshot result;
+    result.vertices.reserve(n);
+    result.offsets.reserve(n + 1);
+    result.targets.reserve(targets.size());
+    result.weights.reserve(weights.size());
+
+    std::vector<std::pair<vertex_id, double>> arcs;
+    for (vertex_id i = 0; i < n; ++i) {
+      vertex_id old = new_to_old[i];
+      result.vertices.push_back(vertices[old]);
+      result.ids.emplace(vertices[old], i);
+
+      arcs.clear();
+      for (size_t a = offsets[old]; a < offsets[old + 1]; ++a) {
+        arcs.emplace_back(old_to_new[targets[a]], weights[a]);
+      }
+      std::sort(arcs.begin(), arcs.end());
+
+      for (const auto& arc: arcs) {
+        result.targets.push_back(arc.first);
+        result.weights.push_back(arc.second);
+      }
+      result.offsets.push_back(result.targets.size());
+    }
+
+    return result;
+  }
+
+private:
+  std::vector<const graph_node<T>*> vertices;
+  std::vector<size_t> offsets;
+  std::vector<vertex_id> targets;
+  std::vector<double> weights;
+  std::unordered_map<const graph_node<T>*, vertex_id,
+                     graph_node_ptr_hash<T>,
+                     graph_node_ptr_equal<T>> ids;
+};
+
+#endif /* GRAPH_SNAPSHOT_HPP */
@@ -0,0 +1,239 @@
+#ifndef GRAPH_VIEWS_HPP
+#define GRAPH_VIEWS_HPP
+
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "adjacency_list.hpp"
+#include "graph_edge.hpp"
+#include "graph_node.hpp"
+
+/*
+ * Views present part of a graph as a graph without copying its
+ *  vertices or neighbour sets. Like adjacency_list, they provide
+ *  for_each_vertex(f) and for_each_adjacent(vertex, f), so to_dot
+ *  can stream them directly. The whole-graph algorithms do not run
+ *  on a view itself: they run on a graph_snapshot built from it,
+ *  which copies the edges the view passes into CSR form. A view
+ *  refers to the graph it was made from, which must outlive it.
+ */
+
+namespace detail
+{
+  /**
+   * Calls f(end1, end2, weight) once for every undirected edge of
+   *  graph, which must hand out a single address per vertex.
+   */
+  template <typename T, typename G, typename F>
+  void for_each_undirected_edge(const G& graph, F f)
+  {
+    graph.for_each_vertex([&graph, &f](const graph_node<T>& vertex) {
+        graph.for_each_adjacent(vertex,
+            [&vertex, &f](const graph_node<T>& other, double weight) {
+              if (!std::less<const graph_node<T>*>()(&other, &vertex)) {
+                f(vertex, other, weight);
+              }
+            });
+      });
+  }
+}
+
+/**
+ * The edges of an adjacency list for which
+ *  predicate(end1, end2, weight) is true, over all of its vertices.
+ *
+ * The predicate is called with the end with the smaller label
+ *  first, by std::less<T>, whichever direction the edge is walked
+ *  in. An edge is therefore kept or dropped as a whole, and the same
+ *  edges are kept on every run, even if the predicate is not
+ *  symmetric.
+ */
+template <typename T, typename P>
+class filtered_graph_view
+{
+public:
+  filtered_graph_view(const adjacency_list<T>& adj_list, P predicate)
+    : adj_list(adj_list), predicate(std::move(predicate))
+  {}
+
+  size_t get_vertex_count() const
+  {
+    return adj_list.get_vertex_count();
+  }
+
+  template <typename F>
+  void for_each_vertex(F f) const
+  {
+    adj_list.for_each_vertex(f);
+  }
+
+  template <typename F>
+  void for_each_adjacent(const graph_node<T>& vertex, F f) const
+  {
+    adj_list.for_each_adjacent(vertex,
+        [this, &vertex, &f](const graph_node<T>& other, double weight) {
+          bool kept = std::less<T>()(other.get_label(), vertex.get_label())
+                        ? predicate(other, vertex, weight)
+                        : predicate(vertex, other, weight);
+          if (kept) {
+            f(other, weight);
+          }
+        });
+  }
+
+  template <typename F>
+  void for_each_edge(F f) const
+  {
+    detail::for_each_undirected_edge<T>(*this, f);
+  }
+
+private:
+  const adjacency_list<T>& adj_list;
+  P predicate;
+};
+
+template <typename T, typename P>
+filtered_graph_view<T, P> make_filtered_view(const adjacency_list<T>& adj_list,
+                                             P predicate)
+{
+  return filtered_graph_view<T, P>(adj_list, std::move(predicate));
+}
+
+/**
+ * The subgraph of an adjacency list induced by a set of its
+ *  vertices: those vertices, and every edge between two of them.
+ */
+template <typename T>
+class induced_subgraph_view
+{
+public:
+  /**
+   * @param first, last A range of graph_node<T>. Vertices that are
+   *                    not in the list are ignored.
+   */
+  template <typename I>
+  induced_subgraph_view(const adjacency_list<T>& adj_list, I first, I last)
+    : adj_list(adj_list)
+  {
+    for (; first != last; ++first) {
+      auto *vertex = adj_list.find_vertex(first->get_label());
+      if (vertex != nullptr) {
+        members.insert(vertex);
+      }
+    }
+  }
+
+  size_t get_vertex_count() const
+  {
+    return members.size();
+  }
+
+  bool contains(const graph_node<T>& vertex) const
+  {
+    return members.find(&vertex) != members.end();
+  }
+
+  template <typename F>
+  void for_each_vertex(F f) const
+  {
+    for (const auto *vertex: members) {
+      f(*vertex);
+    }
+  }
+
+  template <typename F>
+  void for_each_adjacent(const graph_node<T>& vertex, F f) const
+  {
+    if (!contains(vertex)) {
+      return;
+    }
+
+    adj_list.for_each_adjacent(vertex,
+        [this, &f](const graph_node<T>& other, double weight) {
+          if (contains(other)) {
+            f(other, weight);
+          }
+        });
+  }
+
+  template <typename F>
+  void for_each_edge(F f) const
+  {
+    detail::for_each_undirected_edge<T>(*this, f);
+  }
+
+private:
+  const adjacency_list<T>& adj_list;
+  std::unordered_set<const graph_node<T>*,
+                     graph_node_ptr_hash<T>,
+                     graph_node_ptr_equal<T>> members;
+};
+
+/**
+ * A list of edges, such as a spanning tree, seen as a graph over
+ *  their end points.
+ *
+ * Only an index from each vertex to its neighbours is built; the
+ *  edges and the vertices they point to are not copied.
+ */
+template <typename T>
+class edge_list_view
+{
+public:
+  explicit edge_list_view(const std::vector<graph_edge<T>>& edges)
+  {
+    for (const auto& edge: edges) {
+      auto pair = edge.get_vertices();
+      auto *end1 = index.emplace(pair.first, neighbours()).first->first;
+      auto *end2 = index.emplace(pair.second, neighbours()).first->first;
+
+      index[end1].emplace_back(end2, edge.get_weight());
+      if (end1 != end2) {
+        index[end2].emplace_back(end1, edge.get_weight());
+      }
+    }
+  }
+
+  size_t get_vertex_count() const
+  {
+    return index.size();
+  }
+
+  template <typename F>
+  void for_each_vertex(F f) const
+  {
+    for (const auto& entry: index) {
+      f(*entry.first);
+    }
+  }
+
+  template <typename F>
+  void for_each_adjacent(const graph_node<T>& vertex, F f) const
+  {
+    auto it = index.find(&vertex);
+
+    if (it != index.end()) {
+      for (const auto& adjacent: it->second) {
+        f(*adjacent.first, adjacent.second);
+      }
+    }
+  }
+
+  template <typename F>
+  void for_each_edge(F f) const
+  {
+    detail::for_each_undirected_edge<T>(*this, f);
+  }
+
+private:
+  typedef std::vector<std::pair<const graph_node<T>*, double>> neighbours;
+
+  std::unordered_map<const graph_node<T>*, neighbours,
+                     graph_node_ptr_hash<T>,
+                     graph_node_ptr_equal<T>> index;
+};
+
+#endif /* GRAPH_VIEWS_HPP */
@@ -0,0 +1,273 @@
+#ifndef K_CORE_HPP
+#define K_CORE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "adjacency_list.hpp"
+#include "execution_policy.hpp"
+#include "graph_snapshot.hpp"
+
+/**
+ * Result of a k-core decomposition.
+ *
+ * core[v] is the core number of the vertex with dense id v: the
+ *  largest k such that v belongs to a subgraph in which every vertex
+ *  has at least k neighbours. order is a degeneracy ordering, in
+ *  which every vertex has at most degeneracy neighbours later on.
+ */
+struct core_decomposition
+{
+  std::vector<size_t> core;
+  std::vector<vertex_id> order;
+  size_t degeneracy;
+};
+
+namespace detail
+{
+  template <typename T>
+  size_t degree_without_loops(const graph_snapshot<T>& graph, vertex_id v)
+  {
+    auto neighbours = graph.get_neighbours(v);
+    return graph.get_degree(v)
+           - std::count(neighbours.first, neighbours.second, v);
+  }
+}
+
+/**
+ * Batagelj-Zaversnik k-core decomposition in O(V + E).
+ *
+ * Vertices are kept bucket sorted by their current degree and
+ *  removed lowest degree first; removing a vertex moves each of its
+ *  remaining neighbours down one bucket in constant time.
+ */
+template <typename T>
+core_decomposition k_core_decomposition(const graph_snapshot<T>& graph)
+{
+  size_t n = graph.get_vertex_count();
+  core_decomposition result;
+  result.core.resize(n);
+  result.order.resize(n);
+  result.degeneracy = 0;
+
+  std::vector<size_t>& degree = result.core;
+  size_t max_degree = 0;
+  for (vertex_id v = 0; v < n; ++v) {
+    degree[v] = detail::degree_without_loops(graph, v);
+    max_degree = std::max(max_degree, degree[v]);
+  }
+
+  // bin[d] is where the vertices of degree d start in order
+  std::vector<size_t> bin(max_degree + 1, 0);
+  for (vertex_id v = 0; v < n; ++v) {
+    ++bin[degree[v]];
+  }
+
+  size_t start = 0;
+  for (size_t d = 0; d <= max_degree; ++d) {
+    size_t count = bin[d];
+    bin[d] = start;
+    start += count;
+  }
+
+  std::vector<size_t> position(n);
+  for (vertex_id v = 0; v < n; ++v) {
+    position[v] = bin[degree[v]]++;
+    result.order[position[v]] = v;
+  }
+
+  for (size_t d = max_degree; d > 0; --d) {
+    bin[d] = bin[d - 1];
+  }
+  bin[0] = 0;
+
+  for (size_t i = 0; i < n; ++i) {
+    vertex_id v = result.order[i];
+    auto neighbours = graph.get_neighbours(v);
+
+    for (auto it = neighbours.first; it != neighbours.second; ++it) {
+      vertex_id u = *it;
+      if (degree[u] <= degree[v]) {
+        continue;
+      }
+
+      // swap u with the first vertex of its bucket, then shrink the
+      //  bucket past it
+      size_t du = degree[u];
+      size_t pu = position[u];
+      size_t pw = bin[du];
+      vertex_id w = result.order[pw];
+
+      if (u != w) {
+        result.order[pu] = w;
+        position[w] = pu;
+        result.order[pw] = u;
+        position[u] = pw;
+      }
+
+      ++bin[du];
+      --degree[u];
+    }
+
+    result.degeneracy = std::max(result.degeneracy, degree[v]);
+  }
+
+  return result;
+}
+
+/**
+ * Parallel k-core decomposition by level-synchronous peeling.
+ *
+ * For increasing k, every remaining vertex of degree at most k is
+ *  removed with core number k, in parallel, and neighbours whose
+ *  degree drops to k join the next round of the same level. After
+ *  each level k jumps to the smallest degree left, and the frontier
+ *  and the remaining vertices are rebuilt in parallel.
+ */
+template <typename T>
+core_decomposition k_core_decomposition(const graph_snapshot<T>& graph,
+                                        const execution_policy& policy)
+{
+  if (policy.is_sequential()) {
+    return k_core_decomposition(graph);
+  }
+
+  size_t n = graph.get_vertex_count();
+  core_decomposition result;
+  result.core.resize(n);
+  result.order.reserve(n);
+  result.degeneracy = 0;
+
+  std::vector<std::atomic<size_t>> degree(n);
+  std::vector<char> removed(n, 0);
+  std::vector<vertex_id> remaining(n);
+
+  parallel_for(policy, n,
+      [&graph, &degree, &remaining](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+          degree[v].store(detail::degree_without_loops(
+                            graph, static_cast<vertex_id>(v)));
+          remaining[v] = static_cast<vertex_id>(v);
+        }
+      });
+
+  std::mutex frontier_mutex;
+  std::vector<vertex_id> frontier, next;
+
+  // Drops the removed vertices from remaining, in parallel.
+  // @return The smallest degree left, which is the next level.
+  auto compact = [&policy, &degree, &removed, &remaining,
+                  &frontier_mutex]() {
+    std::vector<vertex_id> kept;
+    size_t lowest = std::numeric_limits<size_t>::max();
+
+    parallel_for(policy, remaining.size(),
+        [&](size_t begin, size_t end) {
+          std::vector<vertex_id> local;
+          size_t local_lowest = std::numeric_limits<size_t>::max();
+          for (size_t i = begin; i < end; ++i) {
+            vertex_id v = remaining[i];
+            if (!removed[v]) {
+              local.push_back(v);
+              local_lowest = std::min(local_lowest, degree[v].load());
+            }
+          }
+
+          std::lock_guard<std::mutex> lock(frontier_mutex);
+          kept.insert(kept.end(), local.begin(), local.end());
+          lowest = std::min(lowest, local_lowest);
+        });
+
+    remaining.swap(kept);
+    return lowest;
+  };
+
+  // Levels whose frontier would be empty are skipped: k jumps
+  //  straight to the smallest degree left.
+  for (size_t k = compact(); !remaining.empty(); k = compact()) {
+    frontier.clear();
+    parallel_for(policy, remaining.size(),
+        [&](size_t begin, size_t end) {
+          std::vector<vertex_id> local;
+          for (size_t i = begin; i < end; ++i) {
+            if (degree[remaining[i]].load() <= k) {
+              local.push_back(remaining[i]);
+            }
+          }
+
+          std::lock_guard<std::mutex> lock(frontier_mutex);
+          frontier.insert(frontier.end(), local.begin(), local.end());
+        });
+
+    while (!frontier.empty()) {
+      for (vertex_id v: frontier) {
+        removed[v] = 1;
+        result.core[v] = k;
+      }
+      result.order.insert(result.order.end(),
+                          frontier.begin(), frontier.end());
+      result.degeneracy = k;
+
+      next.clear();
+      parallel_for(policy, frontier.size(),
+          [&](size_t begin, size_t end) {
+            std::vector<vertex_id> local;
+            for (size_t i = begin; i < end; ++i) {
+              auto neighbours = graph.get_neighbours(frontier[i]);
+              for (auto it = neighbours.first; it != neighbours.second; ++it) {
+                if (removed[*it]) {
+                  continue;
+                }
+                if (degree[*it].fetch_sub(1) == k + 1) {
+                  local.push_back(*it);
+                }
+              }
+            }
+
+            std::lock_guard<std::mutex> lock(frontier_mutex);
+            next.insert(next.end(), local.begin(), local.end());
+          });
+
+      frontier.swap(next);
+    }
+  }
+
+  return result;
+}
+
+/**
+ * k-core decomposition of an adjacency list, by vertex.
+ */
+template <typename T>
+struct vertex_core_decomposition
+{
+  std::unordered_map<graph_node<T>, size_t> core;
+  std::vector<const graph_node<T>*> order;
+  size_t degeneracy;
+};
+
+template <typename T>
+vertex_core_decomposition<T> k_core_decomposition(
+                               const adjacency_list<T>& adj_list,
+                               const execution_policy& policy
+                                 = execution_policy::sequential())
+{
+  graph_snapshot<T> snapshot(adj_list);
+  core_decomposition cores = k_core_decomposition(snapshot, policy);
+  vertex_core_decomposition<T> result;
+
+  result.degeneracy = cores.degeneracy;
+  result.order.reserve(cores.order.size());
+  for (vertex_id v: cores.order) {
+    result.order.push_back(&snapshot.get_vertex(v));
+    result.core.emplace(snapshot.get_vertex(v), cores.core[v]);
+  }
+
+  return result;
+}
+
+#endif /* K_CORE_HPP */
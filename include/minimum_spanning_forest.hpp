@@ -0,0 +1,77 @@
+#ifndef MINIMUM_SPANNING_FOREST_HPP
+#define MINIMUM_SPANNING_FOREST_HPP
+
+#include <utility>
+#include <vector>
+
+#include "adjacency_list.hpp"
+#include "graph_edge.hpp"
+#include "graph_snapshot.hpp"
+#include "packed_edge.hpp"
+
+/**
+ * Kruskal's algorithm over packed edges: the edges are radix sorted
+ *  by weight and joined with a union-find indexed by dense id, so
+ *  no vertex is hashed or compared along the way.
+ *
+ * @return The edges of a minimum spanning forest, lightest first.
+ */
+template <typename T>
+std::vector<packed_edge> minimum_spanning_forest(
+                           const graph_snapshot<T>& graph)
+{
+  std::vector<packed_edge> edges = get_packed_edges(graph);
+  radix_sort(edges);
+
+  std::vector<vertex_id> parent(graph.get_vertex_count());
+  std::vector<vertex_id> rank(graph.get_vertex_count(), 0);
+  for (vertex_id v = 0; v < parent.size(); ++v) {
+    parent[v] = v;
+  }
+
+  auto find = [&parent](vertex_id v) {
+    while (parent[v] != v) {
+      parent[v] = parent[parent[v]];   // path halving
+      v = parent[v];
+    }
+    return v;
+  };
+
+  std::vector<packed_edge> forest;
+  for (const auto& edge: edges) {
+    if (forest.size() + 1 >= parent.size()) {
+      break;
+    }
+
+    vertex_id root1 = find(edge.end1), root2 = find(edge.end2);
+    if (root1 == root2) {
+      continue;
+    }
+
+    if (rank[root1] < rank[root2]) {
+      std::swap(root1, root2);
+    }
+    parent[root2] = root1;
+    if (rank[root1] == rank[root2]) {
+      ++rank[root1];
+    }
+
+    forest.push_back(edge);
+  }
+
+  return forest;
+}
+
+/**
+ * A minimum spanning forest of an adjacency list, converted back to
+ *  graph_edges over its vertices.
+ */
+template <typename T>
+std::vector<graph_edge<T>> minimum_spanning_forest(
+                             const adjacency_list<T>& adj_list)
+{
+  graph_snapshot<T> snapshot(adj_list);
+  return to_graph_edges(snapshot, minimum_spanning_forest(snapshot));
+}
+
+#endif /* MINIMUM_SPANNING_FOREST_HPP */
@@ -0,0 +1,165 @@
+#ifndef PACKED_EDGE_HPP
+#define PACKED_EDGE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "graph_edge.hpp"
+#include "graph_snapshot.hpp"
+#include "utility/make_hash.hpp"
+
+/**
+ * An undirected edge between two dense vertex ids of a snapshot.
+ *
+ * Unlike graph_edge it is trivially copyable, compares and hashes
+ *  without touching the vertices, and is ordered by weight alone,
+ *  like graph_edge. Convert back with to_graph_edge() once results
+ *  leave the algorithm.
+ */
+struct packed_edge
+{
+  vertex_id end1, end2;
+  double weight;
+};
+
+static_assert(std::is_trivially_copyable<packed_edge>::value,
+              "packed_edge must stay trivially copyable");
+
+inline bool operator<(const packed_edge& left, const packed_edge& right)
+{
+  return left.weight < right.weight;
+}
+
+inline bool operator>(const packed_edge& left, const packed_edge& right)
+{
+  return left.weight > right.weight;
+}
+
+inline bool operator==(const packed_edge& left, const packed_edge& right)
+{
+  return (left.end1 == right.end1 && left.end2 == right.end2)
+         || (left.end1 == right.end2 && left.end2 == right.end1);
+}
+
+namespace std
+{
+  template <>
+  struct hash<packed_edge>
+  {
+    // Hashes the ends in order. XOR-ing them would send every edge
+    //  (i, i + 1) of a path to one of a handful of values.
+    std::size_t operator()(const packed_edge& edge) const
+    {
+      return make_hash(std::min(edge.end1, edge.end2),
+                       std::max(edge.end1, edge.end2));
+    }
+  };
+}
+
+/**
+ * @return A key whose unsigned order is the order of the weights,
+ *         for radix sorting.
+ */
+inline std::uint64_t radix_key(const packed_edge& edge)
+{
+  std::uint64_t bits;
+  std::memcpy(&bits, &edge.weight, sizeof(bits));
+
+  const std::uint64_t sign = std::uint64_t(1) << 63;
+  return (bits & sign) ? ~bits : (bits | sign);
+}
+
+/**
+ * Sorts edges by increasing weight with a stable LSD radix sort,
+ *  one byte of radix_key() per pass. Passes in which every key has
+ *  the same byte are skipped.
+ */
+inline void radix_sort(std::vector<packed_edge>& edges)
+{
+  std::vector<packed_edge> buffer(edges.size());
+  std::vector<std::uint64_t> keys(edges.size()), key_buffer(edges.size());
+
+  for (size_t i = 0; i < edges.size(); ++i) {
+    keys[i] = radix_key(edges[i]);
+  }
+
+  for (unsigned shift = 0; shift < 64; shift += 8) {
+    size_t counts[256] = { 0 };
+    for (std::uint64_t key: keys) {
+      ++counts[(key >> shift) & 0xff];
+    }
+
+    if (!edges.empty()
+        && counts[(keys[0] >> shift) & 0xff] == edges.size()) {
+      continue;
+    }
+
+    size_t start = 0;
+    for (size_t& count: counts) {
+      size_t c = count;
+      count = start;
+      start += c;
+    }
+
+    for (size_t i = 0; i < edges.size(); ++i) {
+      size_t to = counts[(keys[i] >> shift) & 0xff]++;
+      buffer[to] = edges[i];
+      key_buffer[to] = keys[i];
+    }
+
+    edges.swap(buffer);
+    keys.swap(key_buffer);
+  }
+}
+
+/**
+ * @return Every edge of the snapshot once, with end1 <= end2.
+ */
+template <typename T>
+std::vector<packed_edge> get_packed_edges(const graph_snapshot<T>& graph)
+{
+  std::vector<packed_edge> edges;
+  edges.reserve(graph.get_arc_count() / 2);
+
+  for (vertex_id v = 0; v < graph.get_vertex_count(); ++v) {
+    auto neighbours = graph.get_neighbours(v);
+    const double *weight = graph.get_weights(v).first;
+
+    for (auto it = neighbours.first; it != neighbours.second;
+         ++it, ++weight) {
+      if (v <= *it) {
+        edges.push_back(packed_edge{ v, *it, *weight });
+      }
+    }
+  }
+
+  return edges;
+}
+
+template <typename T>
+graph_edge<T> to_graph_edge(const graph_snapshot<T>& graph,
+                            const packed_edge& edge)
+{
+  return graph_edge<T>(graph.get_vertex(edge.end1),
+                       graph.get_vertex(edge.end2), edge.weight);
+}
+
+template <typename T>
+std::vector<graph_edge<T>> to_graph_edges(
+                             const graph_snapshot<T>& graph,
+                             const std::vector<packed_edge>& edges)
+{
+  std::vector<graph_edge<T>> result;
+  result.reserve(edges.size());
+
+  for (const auto& edge: edges) {
+    result.push_back(to_graph_edge(graph, edge));
+  }
+
+  return result;
+}
+
+#endif /* PACKED_EDGE_HPP */
@@ -0,0 +1,186 @@
+#ifndef SHORTEST_PATH_CACHE_HPP
+#define SHORTEST_PATH_CACHE_HPP
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "adjacency_list.hpp"
+#include "graph_snapshot.hpp"
+#include "shortest_paths.hpp"
+
+/**
+ * Memoizes shortest path trees by source vertex in front of an
+ *  adjacency list.
+ *
+ * Trees are evicted least recently used first once their total
+ *  size exceeds the memory budget. Every lookup compares the list's
+ *  version with the one the cached trees were computed at, and
+ *  drops them all if the list has changed since.
+ *
+ * The cache itself may be shared between threads, but the list
+ *  must not be modified while a lookup runs. Trees and snapshots
+ *  are computed without holding the cache's lock, so lookups of
+ *  different sources run in parallel. A tree computed on a snapshot
+ *  that has been replaced in the meantime is returned but not
+ *  cached.
+ */
+template <typename T>
+class shortest_path_cache
+{
+public:
+  typedef std::shared_ptr<const shortest_path_tree<T>> tree_ptr;
+
+  shortest_path_cache(const adjacency_list<T>& adj_list,
+                      size_t memory_budget)
+    : adj_list(adj_list), memory_budget(memory_budget), memory_usage(0),
+      hits(0), misses(0), version(adj_list.get_version()),
+      snapshot(std::make_shared<const graph_snapshot<T>>(adj_list))
+  {}
+
+  /**
+   * @return The shortest path tree from source, or null if source
+   *         is not a vertex of the list.
+   */
+  tree_ptr get(const graph_node<T>& source)
+  {
+    std::shared_ptr<const graph_snapshot<T>> current = get_current_snapshot();
+
+    vertex_id id = current->get_id(source);
+    if (id == current->get_vertex_count()) {
+      return nullptr;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (snapshot == current) {
+        auto it = entries.find(id);
+        if (it != entries.end()) {
+          ++hits;
+          recency.splice(recency.begin(), recency, it->second.second);
+          return it->second.first;
+        }
+      }
+      ++misses;
+    }
+
+    tree_ptr tree = std::make_shared<const shortest_path_tree<T>>(
+                      single_source_shortest_paths(current, id));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (snapshot != current) {
+      return tree;
+    }
+
+    // Another thread may have cached the same tree meanwhile.
+    auto it = entries.find(id);
+    if (it != entries.end()) {
+      return it->second.first;
+    }
+
+    size_t size = get_tree_size();
+    if (size <= memory_budget) {
+      while (memory_usage + size > memory_budget) {
+        entries.erase(recency.back());
+        recency.pop_back();
+        memory_usage -= size;
+      }
+
+      recency.push_front(id);
+      entries.emplace(id, std::make_pair(tree, recency.begin()));
+      memory_usage += size;
+    }
+
+    return tree;
+  }
+
+  /**
+   * @return The snapshot the cached trees were computed on, which
+   *         maps their dense ids back to vertices.
+   */
+  std::shared_ptr<const graph_snapshot<T>> get_snapshot() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return snapshot;
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    recency.clear();
+    memory_usage = 0;
+  }
+
+  size_t get_memory_usage() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return memory_usage;
+  }
+
+  size_t get_hit_count() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+  }
+
+  size_t get_miss_count() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+  }
+
+private:
+  const adjacency_list<T>& adj_list;
+  size_t memory_budget, memory_usage;
+  size_t hits, misses;
+  unsigned long version;
+  std::shared_ptr<const graph_snapshot<T>> snapshot;
+  std::list<vertex_id> recency;
+  std::unordered_map<vertex_id,
+                     std::pair<tree_ptr,
+                               std::list<vertex_id>::iterator>> entries;
+  mutable std::mutex mutex;
+
+  // All trees of one snapshot have the same size.
+  size_t get_tree_size() const
+  {
+    return sizeof(shortest_path_tree<T>)
+           + snapshot->get_vertex_count()
+               * (sizeof(double) + sizeof(vertex_id));
+  }
+
+  /**
+   * @return The snapshot of the current version of the list. If the
+   *         list has changed, a new snapshot is built outside the
+   *         lock and replaces the cached trees, unless another thread
+   *         has done so first.
+   */
+  std::shared_ptr<const graph_snapshot<T>> get_current_snapshot()
+  {
+    unsigned long list_version = adj_list.get_version();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (version == list_version) {
+        return snapshot;
+      }
+    }
+
+    auto rebuilt = std::make_shared<const graph_snapshot<T>>(adj_list);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (version != list_version) {
+      entries.clear();
+      recency.clear();
+      memory_usage = 0;
+      version = list_version;
+      snapshot = std::move(rebuilt);
+    }
+
+    return snapshot;
+  }
+};
+
+#endif /* SHORTEST_PATH_CACHE_HPP */
@@ -0,0 +1,369 @@
+#ifndef SHORTEST_PATHS_HPP
+#define SHORTEST_PATHS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution_policy.hpp"
+#include "graph_snapshot.hpp"
+
+/**
+ * A dense row-major matrix of path lengths. Unreachable pairs are
+ *  std::numeric_limits<double>::infinity().
+ */
+class distance_matrix
+{
+public:
+  distance_matrix(size_t rows, size_t columns)
+    : rows(rows), columns(columns),
+      cells(rows * columns, std::numeric_limits<double>::infinity())
+  {}
+
+  size_t get_row_count() const
+  { return rows; }
+
+  size_t get_column_count() const
+  { return columns; }
+
+  double& operator()(size_t row, size_t column)
+  { return cells[row * columns + column]; }
+
+  double operator()(size_t row, size_t column) const
+  { return cells[row * columns + column]; }
+
+  double *get_row(size_t row)
+  { return cells.data() + row * columns; }
+
+  const double *get_row(size_t row) const
+  { return cells.data() + row * columns; }
+
+private:
+  size_t rows, columns;
+  std::vector<double> cells;
+};
+
+/**
+ * Scratch space for repeated single-source searches, so that a
+ *  batch of sources allocates it once per thread.
+ */
+struct shortest_path_workspace
+{
+  std::vector<std::pair<double, vertex_id>> heap;
+};
+
+/**
+ * Dijkstra's algorithm from source over a snapshot with
+ *  non-negative weights.
+ *
+ * @param distance Output array of get_vertex_count() entries.
+ * @param precedent If non-null, receives the previous vertex on a
+ *                  shortest path, or get_vertex_count() if none.
+ */
+template <typename T>
+void dijkstra_shortest_paths(const graph_snapshot<T>& graph,
+                             vertex_id source,
+                             double *distance,
+                             vertex_id *precedent,
+                             shortest_path_workspace& workspace)
+{
+  typedef std::pair<double, vertex_id> heap_entry;
+  size_t n = graph.get_vertex_count();
+  std::greater<heap_entry> later;
+  auto& heap = workspace.heap;
+
+  std::fill(distance, distance + n, std::numeric_limits<double>::infinity());
+  if (precedent != nullptr) {
+    std::fill(precedent, precedent + n, static_cast<vertex_id>(n));
+  }
+
+  heap.clear();
+  distance[source] = 0;
+  heap.emplace_back(0.0, source);
+
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), later);
+    heap_entry top = heap.back();
+    heap.pop_back();
+
+    vertex_id v = top.second;
+    if (top.first > distance[v]) {
+      continue;   // stale entry
+    }
+
+    auto neighbours = graph.get_neighbours(v);
+    const double *weight = graph.get_weights(v).first;
+
+    for (auto it = neighbours.first; it != neighbours.second;
+         ++it, ++weight) {
+      double candidate = top.first + *weight;
+      if (candidate < distance[*it]) {
+        distance[*it] = candidate;
+        if (precedent != nullptr) {
+          precedent[*it] = v;
+        }
+        heap.emplace_back(candidate, *it);
+        std::push_heap(heap.begin(), heap.end(), later);
+      }
+    }
+  }
+}
+
+/**
+ * The shortest path tree of one source: the distance of every
+ *  vertex and its precedent on a shortest path, by dense id, as
+ *  dijkstra_entry records them per graph_node.
+ *
+ * The tree keeps the snapshot it was computed on alive, so ids can
+ *  always be mapped back to vertices.
+ */
+template <typename T>
+struct shortest_path_tree
+{
+  std::shared_ptr<const graph_snapshot<T>> graph;
+  vertex_id source;
+  std::vector<double> distance;
+  std::vector<vertex_id> precedent;   // get_vertex_count() if none
+
+  /**
+   * @return The vertices on a shortest path from source to target,
+   *         both included, or nothing if target is unreachable.
+   */
+  std::vector<vertex_id> get_path(vertex_id target) const
+  {
+    std::vector<vertex_id> path;
+
+    if (distance[target] == std::numeric_limits<double>::infinity()) {
+      return path;
+    }
+
+    for (vertex_id v = target; v != source; v = precedent[v]) {
+      path.push_back(v);
+    }
+    path.push_back(source);
+    std::reverse(path.begin(), path.end());
+
+    return path;
+  }
+};
+
+template <typename T>
+shortest_path_tree<T> single_source_shortest_paths(
+                        const std::shared_ptr<const graph_snapshot<T>>& graph,
+                        vertex_id source)
+{
+  shortest_path_tree<T> tree;
+  shortest_path_workspace workspace;
+
+  tree.graph = graph;
+  tree.source = source;
+  tree.distance.resize(graph->get_vertex_count());
+  tree.precedent.resize(graph->get_vertex_count());
+  dijkstra_shortest_paths(*graph, source, tree.distance.data(),
+                          tree.precedent.data(), workspace);
+
+  return tree;
+}
+
+namespace detail
+{
+  template <typename T>
+  bool is_unit_weighted(const graph_snapshot<T>& graph)
+  {
+    for (vertex_id v = 0; v < graph.get_vertex_count(); ++v) {
+      auto weights = graph.get_weights(v);
+      for (auto it = weights.first; it != weights.second; ++it) {
+        if (*it != 1.0) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Multi-source BFS: up to 64 sources advance together, one bit
+   *  each, so every vertex and arc is scanned once per batch
+   *  rather than once per source.
+   */
+  template <typename T>
+  void bit_parallel_bfs(const graph_snapshot<T>& graph,
+                        const vertex_id *sources, size_t source_count,
+                        distance_matrix& result, size_t first_row)
+  {
+    size_t n = graph.get_vertex_count();
+    std::vector<std::uint64_t> seen(n, 0), visit(n, 0), next(n, 0);
+
+    for (size_t i = 0; i < source_count; ++i) {
+      std::uint64_t bit = std::uint64_t(1) << i;
+      seen[sources[i]] |= bit;
+      visit[sources[i]] |= bit;
+      result(first_row + i, sources[i]) = 0;
+    }
+
+    bool active = source_count > 0;
+    for (double level = 1; active; ++level) {
+      for (vertex_id v = 0; v < n; ++v) {
+        if (visit[v] == 0) {
+          continue;
+        }
+        auto neighbours = graph.get_neighbours(v);
+        for (auto it = neighbours.first; it != neighbours.second; ++it) {
+          next[*it] |= visit[v];
+        }
+      }
+
+      active = false;
+      for (vertex_id v = 0; v < n; ++v) {
+        std::uint64_t fresh = next[v] & ~seen[v];
+        next[v] = 0;
+        visit[v] = fresh;
+
+        if (fresh != 0) {
+          active = true;
+          seen[v] |= fresh;
+          for (size_t i = 0; fresh != 0; ++i, fresh >>= 1) {
+            if (fresh & 1) {
+              result(first_row + i, v) = level;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  inline void floyd_warshall_block(distance_matrix& d, size_t n,
+                                   size_t ib, size_t jb, size_t kb,
+                                   size_t block)
+  {
+    size_t i_end = std::min(n, ib + block);
+    size_t j_end = std::min(n, jb + block);
+    size_t k_end = std::min(n, kb + block);
+
+    for (size_t k = kb; k < k_end; ++k) {
+      const double *row_k = d.get_row(k);
+      for (size_t i = ib; i < i_end; ++i) {
+        double *row_i = d.get_row(i);
+        double d_ik = row_i[k];
+        for (size_t j = jb; j < j_end; ++j) {
+          row_i[j] = std::min(row_i[j], d_ik + row_k[j]);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Shortest path lengths from each of the sources to every vertex.
+ *
+ * Row r of the result holds the distances from sources[r], indexed
+ *  by dense vertex id. Graphs whose weights are all 1.0 are searched
+ *  with a bit-parallel BFS, 64 sources at a time; others with one
+ *  Dijkstra per source, reusing a workspace per thread.
+ */
+template <typename T>
+distance_matrix multi_source_shortest_paths(
+                  const graph_snapshot<T>& graph,
+                  const std::vector<vertex_id>& sources,
+                  const execution_policy& policy
+                    = execution_policy::parallel())
+{
+  distance_matrix result(sources.size(), graph.get_vertex_count());
+
+  if (detail::is_unit_weighted(graph)) {
+    size_t batches = (sources.size() + 63) / 64;
+    parallel_for(policy, batches,
+        [&graph, &sources, &result](size_t begin, size_t end) {
+          for (size_t batch = begin; batch < end; ++batch) {
+            size_t first = batch * 64;
+            size_t count = std::min<size_t>(64, sources.size() - first);
+            detail::bit_parallel_bfs(graph, sources.data() + first, count,
+                                     result, first);
+          }
+        });
+  } else {
+    parallel_for(policy, sources.size(),
+        [&graph, &sources, &result](size_t begin, size_t end) {
+          shortest_path_workspace workspace;
+          for (size_t row = begin; row < end; ++row) {
+            dijkstra_shortest_paths(graph, sources[row],
+                                    result.get_row(row), nullptr,
+                                    workspace);
+          }
+        });
+  }
+
+  return result;
+}
+
+/**
+ * All-pairs shortest path lengths by a cache-blocked Floyd-Warshall.
+ *
+ * The matrix is processed in block x block tiles; for each diagonal
+ *  tile the tiles in its row and column, and then all remaining
+ *  tiles, are independent and run in parallel. Intended for dense
+ *  graphs of up to a few thousand vertices.
+ */
+template <typename T>
+distance_matrix all_pairs_shortest_paths(const graph_snapshot<T>& graph,
+                                         const execution_policy& policy
+                                           = execution_policy::parallel(),
+                                         size_t block = 64)
+{
+  size_t n = graph.get_vertex_count();
+  distance_matrix d(n, n);
+
+  for (vertex_id v = 0; v < n; ++v) {
+    auto neighbours = graph.get_neighbours(v);
+    const double *weight = graph.get_weights(v).first;
+    for (auto it = neighbours.first; it != neighbours.second;
+         ++it, ++weight) {
+      d(v, *it) = std::min(d(v, *it), *weight);
+    }
+    d(v, v) = 0;
+  }
+
+  block = std::max<size_t>(1, block);
+  size_t blocks = (n + block - 1) / block;
+
+  for (size_t k = 0; k < blocks; ++k) {
+    size_t kb = k * block;
+    detail::floyd_warshall_block(d, n, kb, kb, kb, block);
+
+    // the other tiles of row k and column k
+    parallel_for(policy, 2 * blocks,
+        [&d, n, k, kb, blocks, block](size_t begin, size_t end) {
+          for (size_t t = begin; t < end; ++t) {
+            size_t other = t % blocks;
+            if (other == k) {
+              continue;
+            }
+            if (t < blocks) {
+              detail::floyd_warshall_block(d, n, kb, other * block, kb, block);
+            } else {
+              detail::floyd_warshall_block(d, n, other * block, kb, kb, block);
+            }
+          }
+        });
+
+    parallel_for(policy, blocks * blocks,
+        [&d, n, k, kb, blocks, block](size_t begin, size_t end) {
+          for (size_t t = begin; t < end; ++t) {
+            size_t i = t / blocks, j = t % blocks;
+            if (i == k || j == k) {
+              continue;
+            }
+            detail::floyd_warshall_block(d, n, i * block, j * block,
+                                         kb, block);
+          }
+        });
+  }
+
+  return d;
+}
+
+#endif /* SHORTEST_PATHS_HPP */
@@ -0,0 +1,206 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed-size pool of worker threads with one task queue per
+ *  worker and work stealing between them.
+ *
+ * Tasks submitted from a worker go to the back of its own queue
+ *  and are popped LIFO by that worker; idle workers steal FIFO
+ *  from the front of the others. Threads that need to wait for
+ *  tasks should help through try_run_one() rather than block, so
+ *  that nested parallelism never needs more threads.
+ */
+class thread_pool
+{
+public:
+  explicit thread_pool(unsigned thread_count
+                         = std::thread::hardware_concurrency())
+    : pending(0), stopping(false), next_queue(0)
+  {
+    thread_count = std::max(1u, thread_count);
+
+    for (unsigned i = 0; i < thread_count; ++i) {
+      queues.emplace_back(new task_queue);
+    }
+
+    for (unsigned i = 0; i < thread_count; ++i) {
+      workers.emplace_back([this, i]() { worker_loop(i); });
+    }
+  }
+
+  ~thread_pool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex);
+      stopping = true;
+    }
+    wakeup.notify_all();
+
+    for (auto& worker: workers) {
+      worker.join();
+    }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  unsigned size() const
+  {
+    return static_cast<unsigned>(queues.size());
+  }
+
+  /**
+   * Queues a task. Tasks must not throw.
+   */
+  void submit(std::function<void()> task)
+  {
+    const worker_slot& slot = current_worker();
+    unsigned index = (slot.pool == this)
+                       ? slot.index
+                       : next_queue++ % size();
+
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex);
+      ++pending;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(queues[index]->mutex);
+      queues[index]->tasks.push_back(std::move(task));
+    }
+    wakeup.notify_one();
+  }
+
+  /**
+   * Runs one queued task on the calling thread, if there is any.
+   * @return true if a task was run.
+   */
+  bool try_run_one()
+  {
+    const worker_slot& slot = current_worker();
+    unsigned start = (slot.pool == this) ? slot.index : 0;
+    std::function<void()> task;
+
+    if (take(start, task)) {
+      task();
+      return true;
+    }
+
+    return false;
+  }
+
+  /**
+   * @return true if the calling thread is one of this pool's
+   *         workers.
+   */
+  bool in_worker() const
+  {
+    return current_worker().pool == this;
+  }
+
+  /**
+   * The process-wide pool, sized to the hardware concurrency.
+   */
+  static thread_pool& get_default()
+  {
+    static thread_pool pool;
+    return pool;
+  }
+
+private:
+  struct task_queue
+  {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  struct worker_slot
+  {
+    const thread_pool *pool;
+    unsigned index;
+  };
+
+  std::vector<std::unique_ptr<task_queue>> queues;
+  std::vector<std::thread> workers;
+  std::mutex sleep_mutex;
+  std::condition_variable wakeup;
+  std::atomic<size_t> pending;
+  bool stopping;
+  std::atomic<unsigned> next_queue;
+
+  static worker_slot& current_worker()
+  {
+    static thread_local worker_slot slot = { nullptr, 0 };
+    return slot;
+  }
+
+  /**
+   * Pops from the back of queue start, or else steals from the
+   *  front of the other queues.
+   */
+  bool take(unsigned start, std::function<void()>& task)
+  {
+    if (pending.load() == 0) {
+      return false;
+    }
+
+    {
+      task_queue& own = *queues[start];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.tasks.empty()) {
+        task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        --pending;
+        return true;
+      }
+    }
+
+    for (unsigned i = 1; i < size(); ++i) {
+      task_queue& victim = *queues[(start + i) % size()];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        --pending;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void worker_loop(unsigned index)
+  {
+    current_worker() = worker_slot{ this, index };
+    std::function<void()> task;
+
+    while (true) {
+      if (take(index, task)) {
+        task();
+        task = nullptr;
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(sleep_mutex);
+      wakeup.wait(lock, [this]() {
+                    return stopping || pending.load() > 0;
+                  });
+      if (stopping) {
+        return;
+      }
+    }
+  }
+};
+
+#endif /* THREAD_POOL_HPP */
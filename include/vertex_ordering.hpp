@@ -0,0 +1,145 @@
+#ifndef VERTEX_ORDERING_HPP
+#define VERTEX_ORDERING_HPP
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "graph_snapshot.hpp"
+
+/**
+ * A renumbering of the vertices of a snapshot.
+ *
+ * new_to_old[i] is the old id of the vertex numbered i, and
+ *  old_to_new is its inverse. Pass new_to_old to
+ *  graph_snapshot::get_permuted() to apply it; the permuted
+ *  snapshot still maps ids back to the same graph_node<T>s.
+ */
+struct vertex_permutation
+{
+  std::vector<vertex_id> new_to_old;
+  std::vector<vertex_id> old_to_new;
+
+  explicit vertex_permutation(std::vector<vertex_id> order)
+    : new_to_old(std::move(order)), old_to_new(new_to_old.size())
+  {
+    for (vertex_id i = 0; i < new_to_old.size(); ++i) {
+      old_to_new[new_to_old[i]] = i;
+    }
+  }
+};
+
+namespace detail
+{
+  /**
+   * Appends a BFS of the component of start to order, visiting the
+   *  neighbours of each vertex by increasing degree if
+   *  by_degree is set, and in storage order otherwise.
+   */
+  template <typename T>
+  void append_bfs(const graph_snapshot<T>& graph, vertex_id start,
+                  bool by_degree, std::vector<bool>& placed,
+                  std::vector<vertex_id>& order)
+  {
+    size_t head = order.size();
+    std::vector<vertex_id> children;
+
+    placed[start] = true;
+    order.push_back(start);
+
+    while (head < order.size()) {
+      vertex_id v = order[head++];
+      auto neighbours = graph.get_neighbours(v);
+
+      children.clear();
+      for (auto it = neighbours.first; it != neighbours.second; ++it) {
+        if (!placed[*it]) {
+          placed[*it] = true;
+          children.push_back(*it);
+        }
+      }
+
+      if (by_degree) {
+        std::stable_sort(children.begin(), children.end(),
+                         [&graph](vertex_id a, vertex_id b) {
+                           return graph.get_degree(a) < graph.get_degree(b);
+                         });
+      }
+
+      order.insert(order.end(), children.begin(), children.end());
+    }
+  }
+}
+
+/**
+ * Orders vertices by degree, highest first by default, so that the
+ *  hubs that most traversals touch are packed together.
+ */
+template <typename T>
+vertex_permutation degree_ordering(const graph_snapshot<T>& graph,
+                                   bool descending = true)
+{
+  std::vector<vertex_id> order(graph.get_vertex_count());
+  for (vertex_id v = 0; v < order.size(); ++v) {
+    order[v] = v;
+  }
+
+  std::stable_sort(order.begin(), order.end(),
+                   [&graph, descending](vertex_id a, vertex_id b) {
+                     return descending
+                              ? graph.get_degree(a) > graph.get_degree(b)
+                              : graph.get_degree(a) < graph.get_degree(b);
+                   });
+
+  return vertex_permutation(std::move(order));
+}
+
+/**
+ * Orders vertices in breadth-first order, one component after the
+ *  other, so that vertices visited together are stored together.
+ */
+template <typename T>
+vertex_permutation bfs_ordering(const graph_snapshot<T>& graph)
+{
+  size_t n = graph.get_vertex_count();
+  std::vector<bool> placed(n, false);
+  std::vector<vertex_id> order;
+  order.reserve(n);
+
+  for (vertex_id v = 0; v < n; ++v) {
+    if (!placed[v]) {
+      detail::append_bfs(graph, v, false, placed, order);
+    }
+  }
+
+  return vertex_permutation(std::move(order));
+}
+
+/**
+ * Reverse Cuthill-McKee ordering, which keeps the neighbours of
+ *  every vertex within a narrow band of ids.
+ *
+ * Each component is searched from its lowest degree vertex,
+ *  visiting neighbours by increasing degree, and the resulting
+ *  order is reversed.
+ */
+template <typename T>
+vertex_permutation reverse_cuthill_mckee(const graph_snapshot<T>& graph)
+{
+  size_t n = graph.get_vertex_count();
+  std::vector<vertex_id> by_degree = degree_ordering(graph, false).new_to_old;
+  std::vector<bool> placed(n, false);
+  std::vector<vertex_id> order;
+  order.reserve(n);
+
+  for (vertex_id v: by_degree) {
+    if (!placed[v]) {
+      detail::append_bfs(graph, v, true, placed, order);
+    }
+  }
+
+  std::reverse(order.begin(), order.end());
+  return vertex_permutation(std::move(order));
+}
+
+#endif /* VERTEX_ORDERING_HPP */
@@ -3,6 +3,7 @@
 
 #include <sstream>
 #include "adjacency_list.hpp"
+#include "graph_views.hpp"
 
 template <typename E>
 std::ostream& to_dot(std::ostream& out,
@@ -49,4 +50,45 @@ std::ostream& to_dot(std::ostream& out,
   return out;
 }
 
+template <typename V>
+std::ostream& view_to_dot(std::ostream& out,
+                          const V& view,
+                          const std::string& graph_name)
+{
+  out << "graph " << graph_name << " {\n";
+  view.for_each_edge([&out](const auto& end1, const auto& end2,
+                            double weight) {
+    out << "\t\"" << end1.get_label() << "\""
+        << " -- \"" << end2.get_label() << "\" "
+        << " [label=\"" << weight << "\"];\n";
+  });
+  out << "}\n";
+
+  return out;
+}
+
+template <typename E, typename P>
+std::ostream& to_dot(std::ostream& out,
+                   const filtered_graph_view<E, P>& view,
+                   const std::string& graph_name)
+{
+  return view_to_dot(out, view, graph_name);
+}
+
+template <typename E>
+std::ostream& to_dot(std::ostream& out,
+                   const induced_subgraph_view<E>& view,
+                   const std::string& graph_name)
+{
+  return view_to_dot(out, view, graph_name);
+}
+
+template <typename E>
+std::ostream& to_dot(std::ostream& out,
+                   const edge_list_view<E>& view,
+                   const std::string& graph_name)
+{
+  return view_to_dot(out, view, graph_name);
+}
+
 #endif /* VISUAL_GRAPH_HPP */
@@ -0,0 +1,109 @@
+#include "adjacency_list.hpp"
+#include "execution_policy.hpp"
+#include "graph_edge.hpp"
+#include "graph_node.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+int main()
+{
+  std::vector<graph_node<std::string>> nodes;
+  for (int i = 0; i < 500; ++i) {
+    nodes.emplace_back("v" + std::to_string(i));
+  }
+
+  std::mt19937 rng(35);
+  std::uniform_int_distribution<int> pick(0, 499);
+  std::vector<graph_edge<std::string>> edges;
+  for (int i = 0; i < 5000; ++i) {
+    int a = pick(rng), b = pick(rng);
+    edges.emplace_back(nodes[a], nodes[b], 1.0 + i % 7);
+  }
+
+  // reference: one edge at a time
+  adjacency_list<std::string> one_by_one;
+  for (auto& node: nodes) {
+    one_by_one.add_vertex(node);
+  }
+  size_t expected = 0;
+  for (auto& edge: edges) {
+    if (one_by_one.add_edge(edge)) {
+      ++expected;
+    }
+  }
+
+  adjacency_list<std::string> bulk;
+  bulk.reserve(nodes.size(), edges.size());
+  for (int i = 0; i < 500; ++i) {
+    const auto& vertex = bulk.emplace_vertex("v" + std::to_string(i));
+    assert(vertex.get_label() == nodes[i].get_label());
+  }
+  assert(&bulk.emplace_vertex("v0") == bulk.find_vertex("v0"));
+
+  auto version = bulk.get_version();
+  size_t added = bulk.add_edges(edges.begin(), edges.end(),
+                                execution_policy::parallel(4));
+  std::cout << "added " << added << " of " << edges.size() << '\n';
+  assert(added == expected);
+  assert(bulk.get_version() != version);
+  assert(bulk.get_edges() == one_by_one.get_edges());
+
+  // get_edges() ignores weights: the first occurrence of a
+  //  duplicated edge must win, in both directions
+  for (auto& node: nodes) {
+    std::map<std::string, double> weights;
+    one_by_one.for_each_adjacent(node,
+        [&weights](const graph_node<std::string>& other, double weight) {
+          weights[other.get_label()] = weight;
+        });
+    bulk.for_each_adjacent(node,
+        [&weights](const graph_node<std::string>& other, double weight) {
+          assert(weights.at(other.get_label()) == weight);
+        });
+  }
+
+  version = bulk.get_version();
+  assert(bulk.add_edges(edges.begin(), edges.end()) == 0);
+  assert(bulk.get_version() == version);
+
+  // existing weights are kept, and duplicates in a batch keep the
+  //  weight they first appear with
+  adjacency_list<std::string> small;
+  graph_node<std::string> x("x"), y("y"), z("z");
+  small.add_vertex(x);
+  small.add_vertex(y);
+  small.add_vertex(z);
+  small.add_edge(x, z, 3.0);
+
+  std::vector<graph_edge<std::string>> batch = {
+    graph_edge<std::string>(x, y, 2.0),
+    graph_edge<std::string>(y, x, 9.0),
+    graph_edge<std::string>(x, z, 7.0),
+    graph_edge<std::string>(x, y, 5.0)
+  };
+  assert(small.add_edges(batch.begin(), batch.end(),
+                         execution_policy::parallel(2)) == 1);
+
+  std::map<std::pair<std::string, std::string>, double> small_weights;
+  for (auto *vertex: { &x, &y, &z }) {
+    small.for_each_adjacent(*vertex,
+        [&small_weights, vertex](const graph_node<std::string>& other,
+                                 double weight) {
+          small_weights[std::make_pair(vertex->get_label(),
+                                       other.get_label())] = weight;
+        });
+  }
+  assert(small_weights.size() == 4);
+  assert(small_weights.at(std::make_pair("x", "y")) == 2.0);
+  assert(small_weights.at(std::make_pair("y", "x")) == 2.0);
+  assert(small_weights.at(std::make_pair("x", "z")) == 3.0);
+  assert(small_weights.at(std::make_pair("z", "x")) == 3.0);
+
+  std::cout << "OK\n";
+}
@@ -292,5 +292,20 @@ int main()
 
     std::cout << vertex.get_label() << ": " << info.min_distance << '\n';
   }
+
+  // a copy must not refer to the vertices of the list it came from
+  auto *original = new adjacency_list<std::string>(adj_list2);
+  adjacency_list<std::string> copy(*original);
+  adjacency_list<std::string> assigned;
+  assigned = *original;
+  delete original;
+
+  for (auto *list: { &copy, &assigned }) {
+    assert(!list->add_edge(n1, n2, 2));
+    assert(list->get_degree(n1) == 3);
+    assert(list->get_edges() == adj_list2.get_edges());
+  }
+  assert(copy.add_edge(n1, n7, 9));
+  assert(copy.get_degree(n7) == 4 && assigned.get_degree(n7) == 3);
 }
 
@@ -0,0 +1,112 @@
+#include "adjacency_list.hpp"
+#include "compressed_graph.hpp"
+#include "connected_components.hpp"
+#include "graph_snapshot.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main()
+{
+  std::vector<graph_node<int>> nodes;
+  for (int i = 0; i < 2000; ++i) {
+    nodes.emplace_back(i);
+  }
+
+  adjacency_list<int> adj_list;
+  for (auto& node: nodes) {
+    adj_list.add_vertex(node);
+  }
+
+  std::mt19937 rng(30);
+  std::uniform_int_distribution<int> pick(0, 1999);
+  std::uniform_real_distribution<double> weigh(1.0, 100.0);
+  for (int i = 0; i < 10000; ++i) {
+    adj_list.add_edge(nodes[pick(rng)], nodes[pick(rng)], weigh(rng));
+  }
+
+  graph_snapshot<int> snapshot(adj_list);
+  compressed_graph<int> exact(snapshot);
+  compressed_graph<int> quantized(snapshot, weight_encoding::quantized);
+  compressed_graph<int> unweighted(adj_list, weight_encoding::unweighted);
+
+  std::cout << "arcs: " << snapshot.get_arc_count()
+            << ", bytes exact: " << exact.get_encoded_size()
+            << ", quantized: " << quantized.get_encoded_size()
+            << ", unweighted: " << unweighted.get_encoded_size() << '\n';
+
+  for (vertex_id v = 0; v < snapshot.get_vertex_count(); ++v) {
+    assert(exact.get_degree(v) == snapshot.get_degree(v));
+    assert(exact.get_vertex(v) == snapshot.get_vertex(v));
+
+    auto neighbours = snapshot.get_neighbours(v);
+    const double *weight = snapshot.get_weights(v).first;
+    for (auto it = neighbours.first; it != neighbours.second;
+         ++it, ++weight) {
+      bool found = false;
+      vertex_id previous = 0;
+      size_t count = 0;
+
+      for (const auto& n: exact.get_neighbours(v)) {
+        assert(count++ == 0 || n.id > previous);
+        previous = n.id;
+        if (n.id == *it) {
+          assert(n.weight == *weight);
+          found = true;
+        }
+      }
+      assert(found && count == snapshot.get_degree(v));
+
+      for (const auto& n: quantized.get_neighbours(v)) {
+        if (n.id == *it) {
+          assert(std::fabs(n.weight - *weight) < 0.01);
+        }
+      }
+    }
+
+    for (const auto& n: unweighted.get_neighbours(v)) {
+      assert(n.weight == 1.0);
+    }
+  }
+
+  assert(unweighted.get_id(nodes[42]) == snapshot.get_id(nodes[42]));
+
+  // encoding straight from the list gives the same bytes
+  compressed_graph<int> direct(adj_list, weight_encoding::quantized);
+  assert(direct.get_encoded_size() == quantized.get_encoded_size());
+  for (vertex_id v = 0; v < snapshot.get_vertex_count(); ++v) {
+    assert(direct.get_id(snapshot.get_vertex(v)) == v);
+    auto expected = quantized.get_neighbours(v).begin();
+    for (const auto& n: direct.get_neighbours(v)) {
+      assert(n.id == expected->id && n.weight == expected->weight);
+      ++expected;
+    }
+  }
+
+  // the compressed graph outlives the list it was built from
+  compressed_graph<int> *owner;
+  {
+    adjacency_list<int> path;
+    for (int i = 0; i < 5; ++i) {
+      path.add_vertex(graph_node<int>(i));
+    }
+    for (int i = 0; i < 4; ++i) {
+      path.add_edge(graph_node<int>(i), graph_node<int>(i + 1), i + 0.5);
+    }
+    owner = new compressed_graph<int>(path);
+  }
+
+  graph_snapshot<int> decoded(*owner);
+  assert(decoded.get_vertex_count() == 5);
+  assert(decoded.get_arc_count() == 8);
+  assert(decoded.get_vertex(decoded.get_id(graph_node<int>(3)))
+           .get_label() == 3);
+  component_labels labels = connected_components(decoded);
+  assert(labels.get_component_count() == 1);
+  delete owner;
+
+  std::cout << "OK\n";
+}
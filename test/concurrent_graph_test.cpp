@@ -0,0 +1,97 @@
+#include "concurrent_graph.hpp"
+#include "connected_components.hpp"
+#include "graph_snapshot.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+int main()
+{
+  concurrent_adjacency_list<int> graph;
+  assert(graph.get_snapshot()->get_vertex_count() == 0);
+
+  std::atomic<bool> done(false);
+  std::atomic<int> started(0);
+  std::atomic<long> reads(0);
+
+  // readers check that every snapshot they see is a whole number
+  //  of fully linked batches
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 3; ++r) {
+    readers.emplace_back([&graph, &done, &started, &reads]() {
+      ++started;
+      do {
+        auto snapshot = graph.get_snapshot();
+        size_t n = snapshot->get_vertex_count();
+        assert(n % 10 == 0);
+        assert(snapshot->get_arc_count() == 2 * (n - n / 10));
+
+        graph_snapshot<int> csr(*snapshot);
+        assert(csr.get_arc_count() == snapshot->get_arc_count());
+        component_labels labels = connected_components(
+                                    csr, execution_policy::sequential());
+        assert(labels.get_component_count() == n / 10);
+        ++reads;
+      } while (!done.load());
+    });
+  }
+
+  while (started.load() < 3) {
+    std::this_thread::yield();
+  }
+
+  std::shared_ptr<const graph_version<int>> first;
+
+  for (int b = 0; b < 50; ++b) {
+    graph_update_batch<int> batch;
+    for (int i = 0; i < 10; ++i) {
+      batch.add_vertex(graph_node<int>(b * 10 + i));
+    }
+    for (int i = 0; i + 1 < 10; ++i) {
+      batch.add_edge(b * 10 + i, b * 10 + i + 1);
+    }
+    graph.apply(batch);
+    if (b == 0) {
+      first = graph.get_snapshot();
+    }
+  }
+
+  done = true;
+  for (auto& reader: readers) {
+    reader.join();
+  }
+
+  auto last = graph.get_snapshot();
+  std::cout << "vertices: " << last->get_vertex_count()
+            << ", reads: " << reads << '\n';
+  assert(reads > 0);
+  assert(last->get_vertex_count() == 500);
+  assert(last->get_vertex(123).get_label() == 123);
+  assert(last->get_id(graph_node<int>(123)) == 123);
+  assert(last->get_degree(last->get_id(graph_node<int>(125))) == 2);
+
+  // older versions are unaffected by later batches
+  assert(first->get_vertex_count() == 10);
+  assert(first->get_arc_count() == 18);
+  assert(first->get_id(graph_node<int>(10)) == 10);
+  assert(first->get_degree(9) == 1);
+
+  graph_update_batch<int> link;
+  link.add_edge(9, 10, 2.5);
+  link.add_edge(9, 9999);
+  graph.apply(link);
+  assert(graph.get_snapshot()->get_degree(9) == 2);
+  assert(last->get_degree(9) == 1);
+  assert(first->get_degree(9) == 1);
+
+  last = graph.get_snapshot();
+  auto version = graph.get_version();
+  assert(graph.apply(graph_update_batch<int>()) == version);
+  assert(graph.get_snapshot() == last);
+
+  std::cout << "OK\n";
+}
@@ -0,0 +1,57 @@
+#include "adjacency_list.hpp"
+#include "connected_components.hpp"
+#include "graph_snapshot.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main()
+{
+  std::vector<graph_node<int>> nodes;
+  for (int i = 0; i < 1000; ++i) {
+    nodes.emplace_back(i);
+  }
+
+  adjacency_list<int> adj_list;
+  for (auto& node: nodes) {
+    adj_list.add_vertex(node);
+  }
+
+  // one big chain, a triangle, and isolated vertices 995..999
+  for (int i = 0; i + 1 < 900; ++i) {
+    adj_list.add_edge(nodes[i], nodes[i + 1]);
+  }
+  for (int i = 900; i < 990; i += 3) {
+    adj_list.add_edge(nodes[i], nodes[i + 1]);
+    adj_list.add_edge(nodes[i + 1], nodes[i + 2]);
+    adj_list.add_edge(nodes[i + 2], nodes[i]);
+  }
+
+  graph_snapshot<int> snapshot(adj_list);
+  component_labels labels = connected_components(snapshot,
+                                  execution_policy::parallel(4));
+
+  std::cout << "components: " << labels.get_component_count() << '\n';
+  assert(labels.get_component_count() == 1 + 30 + 10);
+
+  auto chain = labels.component[snapshot.get_id(nodes[0])];
+  assert(labels.sizes[chain] == 900);
+  assert(labels.component[snapshot.get_id(nodes[899])] == chain);
+  assert(labels.component[snapshot.get_id(nodes[900])]
+         == labels.component[snapshot.get_id(nodes[902])]);
+  assert(labels.component[snapshot.get_id(nodes[900])]
+         != labels.component[snapshot.get_id(nodes[903])]);
+
+  auto by_vertex = connected_components(adj_list,
+                                        execution_policy::sequential());
+  assert(by_vertex.component.at(nodes[10])
+         == by_vertex.component.at(nodes[500]));
+  assert(by_vertex.component.at(nodes[995])
+         != by_vertex.component.at(nodes[996]));
+  assert(by_vertex.get_component_count() == labels.get_component_count());
+  assert(by_vertex.sizes[by_vertex.component.at(nodes[10])] == 900);
+
+  std::cout << "OK\n";
+}
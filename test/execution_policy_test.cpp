@@ -0,0 +1,85 @@
+#include "execution_policy.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+int main()
+{
+  std::vector<long> values(100000);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<long>(i);
+  }
+
+  std::atomic<long> sum(0);
+  parallel_for(execution_policy::parallel(4), values.size(),
+               [&values, &sum](size_t begin, size_t end) {
+                 long local = 0;
+                 for (size_t i = begin; i < end; ++i) {
+                   local += values[i];
+                 }
+                 sum += local;
+               });
+  std::cout << "sum: " << sum << '\n';
+  assert(sum == 4999950000L);
+
+  // nested loops on a large pool must stay within the policy's
+  //  bound, and must not deadlock
+  thread_pool pool(8);
+  execution_policy bounded = execution_policy::parallel(2, &pool);
+  std::atomic<int> active(0), peak(0);
+  std::atomic<long> cells(0);
+
+  auto enter = [&active, &peak]() {
+    int now = ++active;
+    int seen = peak.load();
+    while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+    }
+  };
+
+  parallel_for(bounded, 20,
+               [&](size_t begin, size_t end) {
+                 for (size_t i = begin; i < end; ++i) {
+                   parallel_for(bounded, 20,
+                                [&](size_t b, size_t e) {
+                                  enter();
+                                  std::this_thread::sleep_for(
+                                    std::chrono::microseconds(200));
+                                  cells += static_cast<long>(e - b);
+                                  --active;
+                                });
+                 }
+               });
+  std::cout << "cells: " << cells << ", peak: " << peak << '\n';
+  assert(cells == 400);
+  assert(peak <= 2);
+
+  std::thread::id caller = std::this_thread::get_id();
+  bool same_thread = true;
+  parallel_for(execution_policy::sequential(), 1000,
+               [&caller, &same_thread](size_t, size_t) {
+                 same_thread = same_thread
+                                 && std::this_thread::get_id() == caller;
+               });
+  assert(same_thread);
+
+  bool caught = false;
+  try {
+    parallel_for(execution_policy::parallel(4), 1000,
+                 [](size_t begin, size_t) {
+                   if (begin > 500) {
+                     throw std::runtime_error("boom");
+                   }
+                 });
+  } catch (const std::runtime_error&) {
+    caught = true;
+  }
+  assert(caught);
+
+  std::cout << "OK\n";
+}
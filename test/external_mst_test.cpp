@@ -0,0 +1,95 @@
+#include "external_mst.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+struct reference_edge
+{
+  int end1, end2;
+  double weight;
+};
+
+int find_root(std::vector<int>& parent, int v)
+{
+  while (parent[v] != v) {
+    v = parent[v] = parent[parent[v]];
+  }
+  return v;
+}
+
+int main()
+{
+  std::mt19937 rng(34);
+  std::uniform_int_distribution<int> pick(0, 299);
+  std::uniform_real_distribution<double> weigh(0.0, 50.0);
+
+  std::vector<reference_edge> edges;
+  std::stringstream input;
+  for (int i = 0; i < 3000; ++i) {
+    reference_edge edge = { pick(rng), pick(rng), weigh(rng) };
+    edges.push_back(edge);
+    input.precision(17);
+    input << edge.end1 << ' ' << edge.end2 << ' ' << edge.weight << '\n';
+  }
+
+  // small runs and fan-in force several merge passes
+  std::stringstream output;
+  output.precision(3);
+  size_t count = external_minimum_spanning_forest<int>(input, output, 100, 4);
+  assert(output.precision() == 3);
+
+  double total = 0;
+  edge_record<int> record;
+  size_t read_back = 0;
+  while (output >> record) {
+    total += record.weight;
+    ++read_back;
+  }
+
+  std::sort(edges.begin(), edges.end(),
+            [](const reference_edge& a, const reference_edge& b) {
+              return a.weight < b.weight;
+            });
+  std::vector<int> parent(300);
+  std::iota(parent.begin(), parent.end(), 0);
+  double expected = 0;
+  size_t expected_count = 0;
+  for (const auto& edge: edges) {
+    int r1 = find_root(parent, edge.end1), r2 = find_root(parent, edge.end2);
+    if (r1 != r2) {
+      parent[r1] = r2;
+      expected += edge.weight;
+      ++expected_count;
+    }
+  }
+
+  std::cout << "forest edges: " << count << ", weight: " << total << '\n';
+  assert(count == expected_count && read_back == count);
+  assert(std::fabs(total - expected) < 1e-6);
+
+  // runs spilled to a given directory
+  std::stringstream spilled_input("0 1 2.0\n1 2 1.0\n0 2 3.0\n  \n"),
+                    spilled_output;
+  assert(external_minimum_spanning_forest<int>(spilled_input, spilled_output,
+                                               1, 2, ".") == 2);
+
+  for (const char *malformed: { "0 1 2.0\n1 x 1.0\n", "0 1 2.0\n1 2\n" }) {
+    std::stringstream bad_input(malformed), bad_output;
+    bool thrown = false;
+    try {
+      external_minimum_spanning_forest<int>(bad_input, bad_output);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    assert(thrown);
+  }
+
+  std::cout << "OK\n";
+}
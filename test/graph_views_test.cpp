@@ -0,0 +1,74 @@
+#include "adjacency_list.hpp"
+#include "connected_components.hpp"
+#include "graph_snapshot.hpp"
+#include "graph_views.hpp"
+#include "visual_graph.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main()
+{
+  graph_node<std::string> a("a"), b("b"), c("c"), d("d"), e("e");
+  adjacency_list<std::string> adj_list;
+
+  for (auto *node: { &a, &b, &c, &d, &e }) {
+    adj_list.add_vertex(*node);
+  }
+  adj_list.add_edge(a, b, 1.0);
+  adj_list.add_edge(b, c, 5.0);
+  adj_list.add_edge(c, d, 2.0);
+  adj_list.add_edge(d, e, 7.0);
+  adj_list.add_edge(a, e, 3.0);
+
+  auto light = make_filtered_view(adj_list,
+                  [](const graph_node<std::string>&,
+                     const graph_node<std::string>&,
+                     double weight) { return weight < 4.0; });
+
+  graph_snapshot<std::string> light_graph(light);
+  assert(light_graph.get_vertex_count() == 5);
+  assert(light_graph.get_arc_count() == 6);
+  component_labels labels = connected_components(light_graph);
+  assert(labels.get_component_count() == 2);
+  to_dot(std::cout, light, "light");
+
+  // an asymmetric predicate still keeps or drops whole edges
+  auto from_a = make_filtered_view(adj_list,
+                  [](const graph_node<std::string>& end1,
+                     const graph_node<std::string>&,
+                     double) { return end1.get_label() == "a"; });
+  graph_snapshot<std::string> from_a_graph(from_a);
+  // only a-b and a-e have "a" as their smaller end
+  assert(from_a_graph.get_arc_count() == 4);
+  assert(from_a_graph.get_degree(from_a_graph.get_id(a)) == 2);
+  for (vertex_id v = 0; v < from_a_graph.get_vertex_count(); ++v) {
+    auto neighbours = from_a_graph.get_neighbours(v);
+    for (auto it = neighbours.first; it != neighbours.second; ++it) {
+      auto back = from_a_graph.get_neighbours(*it);
+      assert(std::count(back.first, back.second, v) == 1);
+    }
+  }
+
+  std::vector<graph_node<std::string>> slice = { a, b, e, graph_node<std::string>("z") };
+  induced_subgraph_view<std::string> induced(adj_list, slice.begin(), slice.end());
+  graph_snapshot<std::string> induced_graph(induced);
+  assert(induced_graph.get_vertex_count() == 3);
+  assert(induced_graph.get_arc_count() == 4);
+  to_dot(std::cout, induced, "induced");
+
+  std::vector<graph_edge<std::string>> path = {
+    graph_edge<std::string>(a, b, 1.0),
+    graph_edge<std::string>(b, c, 5.0)
+  };
+  edge_list_view<std::string> edges(path);
+  graph_snapshot<std::string> path_graph(edges);
+  assert(path_graph.get_vertex_count() == 3);
+  assert(path_graph.get_degree(path_graph.get_id(b)) == 2);
+  to_dot(std::cout, edges, "path");
+
+  std::cout << "OK\n";
+}
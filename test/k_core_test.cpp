@@ -0,0 +1,109 @@
+#include "adjacency_list.hpp"
+#include "graph_snapshot.hpp"
+#include "k_core.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main()
+{
+  // a 5-clique with a tail of three vertices hanging off it, and a
+  //  triangle on the side
+  std::vector<graph_node<int>> nodes;
+  for (int i = 0; i < 11; ++i) {
+    nodes.emplace_back(i);
+  }
+
+  adjacency_list<int> adj_list;
+  for (auto& node: nodes) {
+    adj_list.add_vertex(node);
+  }
+  for (int i = 0; i < 5; ++i) {
+    for (int j = i + 1; j < 5; ++j) {
+      adj_list.add_edge(nodes[i], nodes[j]);
+    }
+  }
+  adj_list.add_edge(nodes[4], nodes[5]);
+  adj_list.add_edge(nodes[5], nodes[6]);
+  adj_list.add_edge(nodes[6], nodes[7]);
+  adj_list.add_edge(nodes[8], nodes[9]);
+  adj_list.add_edge(nodes[9], nodes[10]);
+  adj_list.add_edge(nodes[10], nodes[8]);
+  adj_list.add_edge(nodes[10], nodes[10]);
+
+  assert(adj_list.get_degree(nodes[4]) == 5);
+  assert(adj_list.get_degree(graph_node<int>(42)) == 0);
+
+  auto cores = k_core_decomposition(adj_list);
+  std::cout << "degeneracy: " << cores.degeneracy << '\n';
+  assert(cores.degeneracy == 4);
+  assert(cores.core.at(nodes[0]) == 4 && cores.core.at(nodes[4]) == 4);
+  assert(cores.core.at(nodes[5]) == 1 && cores.core.at(nodes[7]) == 1);
+  assert(cores.core.at(nodes[10]) == 2);
+
+  // sequential and parallel agree on a larger random graph, and both
+  //  orders are degeneracy orders
+  std::vector<graph_node<int>> many;
+  for (int i = 0; i < 3000; ++i) {
+    many.emplace_back(i);
+  }
+  adjacency_list<int> random_graph;
+  for (auto& node: many) {
+    random_graph.add_vertex(node);
+  }
+  std::mt19937 rng(36);
+  std::uniform_int_distribution<int> pick(0, 2999);
+  for (int i = 0; i < 20000; ++i) {
+    random_graph.add_edge(many[pick(rng)], many[pick(rng) % (1 + i % 3000)]);
+  }
+
+  graph_snapshot<int> snapshot(random_graph);
+  core_decomposition sequential = k_core_decomposition(snapshot);
+  core_decomposition parallel = k_core_decomposition(
+                                  snapshot, execution_policy::parallel(4));
+
+  assert(sequential.core == parallel.core);
+  assert(sequential.degeneracy == parallel.degeneracy);
+
+  for (const auto *decomposition: { &sequential, &parallel }) {
+    std::vector<size_t> rank(snapshot.get_vertex_count());
+    for (size_t i = 0; i < decomposition->order.size(); ++i) {
+      rank[decomposition->order[i]] = i;
+    }
+    for (vertex_id v = 0; v < snapshot.get_vertex_count(); ++v) {
+      size_t later = 0;
+      auto neighbours = snapshot.get_neighbours(v);
+      for (auto it = neighbours.first; it != neighbours.second; ++it) {
+        if (rank[*it] > rank[v]) {
+          ++later;
+        }
+      }
+      assert(later <= decomposition->degeneracy);
+    }
+  }
+
+  std::cout << "random degeneracy: " << sequential.degeneracy << '\n';
+  // on a clique every level below the clique's is skipped
+  adjacency_list<int> clique;
+  for (int i = 0; i < 40; ++i) {
+    clique.add_vertex(graph_node<int>(i));
+  }
+  for (int i = 0; i < 40; ++i) {
+    for (int j = i + 1; j < 40; ++j) {
+      clique.add_edge(graph_node<int>(i), graph_node<int>(j));
+    }
+  }
+  graph_snapshot<int> clique_snapshot(clique);
+  core_decomposition clique_cores = k_core_decomposition(
+                                      clique_snapshot,
+                                      execution_policy::parallel(4));
+  assert(clique_cores.degeneracy == 39);
+  assert(clique_cores.order.size() == 40);
+  for (size_t core: clique_cores.core) {
+    assert(core == 39);
+  }
+
+  std::cout << "OK\n";
+}
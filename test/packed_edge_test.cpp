@@ -0,0 +1,89 @@
+#include "adjacency_list.hpp"
+#include "graph_snapshot.hpp"
+#include "minimum_spanning_forest.hpp"
+#include "packed_edge.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+int main()
+{
+  std::mt19937 rng(37);
+  std::uniform_real_distribution<double> weigh(-1000.0, 1000.0);
+  std::vector<packed_edge> edges;
+  for (vertex_id i = 0; i < 10000; ++i) {
+    edges.push_back(packed_edge{ i, i + 1, weigh(rng) });
+  }
+  edges.push_back(packed_edge{ 0, 0, 0.0 });
+  edges.push_back(packed_edge{ 0, 0, -0.5 });
+
+  std::vector<packed_edge> expected = edges;
+  std::stable_sort(expected.begin(), expected.end());
+  radix_sort(edges);
+  for (size_t i = 0; i < edges.size(); ++i) {
+    assert(edges[i].weight == expected[i].weight);
+  }
+
+  std::unordered_set<packed_edge> set = { packed_edge{ 1, 2, 3.0 } };
+  assert(set.count(packed_edge{ 2, 1, 7.0 }) == 1);
+
+  // the edges of a long path must not pile up in a few buckets
+  std::unordered_set<packed_edge> path;
+  for (vertex_id i = 0; i < 40000; ++i) {
+    path.insert(packed_edge{ i + 1, i, 1.0 });
+  }
+  assert(path.size() == 40000);
+  assert(path.count(packed_edge{ 20000, 19999, 0.0 }) == 1);
+
+  size_t largest_bucket = 0;
+  for (size_t b = 0; b < path.bucket_count(); ++b) {
+    largest_bucket = std::max(largest_bucket, path.bucket_size(b));
+  }
+  std::cout << "largest bucket: " << largest_bucket << '\n';
+  assert(largest_bucket <= 16);
+
+  graph_node<std::string> n0("0"), n1("1"), n2("2"), n3("3"),
+                  n4("4"), n5("5"), n6("6"), n7("7"), n8("8");
+  adjacency_list<std::string> adj_list;
+
+  for (auto *node: { &n0, &n1, &n2, &n3, &n4, &n5, &n6, &n7, &n8 }) {
+    adj_list.add_vertex(*node);
+  }
+
+  adj_list.add_edge(n0, n1, 4.0);
+  adj_list.add_edge(n0, n7, 8.0);
+  adj_list.add_edge(n1, n2, 8.0);
+  adj_list.add_edge(n1, n7, 11.0);
+  adj_list.add_edge(n2, n8, 2.0);
+  adj_list.add_edge(n7, n8, 7.0);
+  adj_list.add_edge(n6, n8, 6.0);
+  adj_list.add_edge(n6, n7, 1.0);
+  adj_list.add_edge(n2, n3, 7.0);
+  adj_list.add_edge(n2, n5, 4.0);
+  adj_list.add_edge(n6, n5, 2.0);
+  adj_list.add_edge(n3, n5, 14.0);
+  adj_list.add_edge(n3, n4, 9.0);
+  adj_list.add_edge(n4, n5, 10.0);
+
+  graph_snapshot<std::string> snapshot(adj_list);
+  assert(get_packed_edges(snapshot).size() == 14);
+
+  std::vector<graph_edge<std::string>> mst = minimum_spanning_forest(adj_list);
+  double total = 0;
+  for (auto& edge: mst) {
+    std::cout << edge.get_vertices().first->get_label()
+              << "<->" << edge.get_vertices().second->get_label()
+              << "|" << edge.get_weight() << '\n';
+    total += edge.get_weight();
+  }
+
+  assert(mst.size() == 8);
+  assert(total == 37.0);
+
+  std::cout << "OK\n";
+}
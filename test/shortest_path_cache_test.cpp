@@ -0,0 +1,81 @@
+#include "adjacency_list.hpp"
+#include "shortest_path_cache.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main()
+{
+  graph_node<std::string> a("a"), b("b"), c("c"), d("d");
+  adjacency_list<std::string> adj_list;
+
+  adj_list.add_vertex(a);
+  adj_list.add_vertex(b);
+  adj_list.add_vertex(c);
+  adj_list.add_edge(a, b, 1.0);
+  adj_list.add_edge(b, c, 2.0);
+  adj_list.add_edge(a, c, 5.0);
+
+  auto version = adj_list.get_version();
+  adj_list.add_vertex(a);
+  adj_list.add_edge(a, b, 1.0);
+  assert(adj_list.get_version() == version);
+
+  // room for two trees of three vertices
+  shortest_path_cache<std::string> cache(adj_list, 2 * (
+                                           sizeof(shortest_path_tree<std::string>)
+                                           + 3 * (sizeof(double)
+                                                  + sizeof(vertex_id))));
+
+  auto tree = cache.get(a);
+  auto snapshot = cache.get_snapshot();
+  std::cout << "a -> c: " << tree->distance[snapshot->get_id(c)] << '\n';
+  assert(tree->distance[snapshot->get_id(c)] == 3.0);
+  assert(tree->get_path(snapshot->get_id(c)).size() == 3);
+
+  assert(cache.get(a) == tree);
+  cache.get(b);
+  cache.get(c);   // evicts a
+  assert(cache.get_hit_count() == 1 && cache.get_miss_count() == 3);
+  assert(cache.get(a) != tree);
+  assert(cache.get(d) == nullptr);
+
+  adj_list.add_vertex(d);
+  adj_list.add_edge(c, d, 1.0);
+  auto updated = cache.get(a);
+  assert(updated->graph != snapshot);
+  assert(updated->distance[updated->graph->get_id(d)] == 4.0);
+
+  // concurrent lookups on a path agree with each other
+  std::vector<graph_node<int>> path;
+  adjacency_list<int> path_list;
+  for (int i = 0; i < 50; ++i) {
+    path.emplace_back(i);
+    path_list.add_vertex(path.back());
+  }
+  for (int i = 0; i + 1 < 50; ++i) {
+    path_list.add_edge(path[i], path[i + 1], 1.0);
+  }
+
+  shortest_path_cache<int> shared(path_list, 1 << 20);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&shared, &path, t]() {
+      for (int i = 0; i < 50; ++i) {
+        int source = (i * 7 + t) % 50;
+        auto found = shared.get(path[source]);
+        vertex_id zero = found->graph->get_id(path[0]);
+        assert(found->distance[zero] == source);
+      }
+    });
+  }
+  for (auto& thread: threads) {
+    thread.join();
+  }
+  assert(shared.get_hit_count() + shared.get_miss_count() == 200);
+
+  std::cout << "OK\n";
+}
@@ -0,0 +1,89 @@
+#include "adjacency_list.hpp"
+#include "graph_snapshot.hpp"
+#include "shortest_paths.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+int main()
+{
+  graph_node<std::string> n0("0"), n1("1"), n2("2"), n3("3"),
+                  n4("4"), n5("5"), n6("6"), n7("7"), n8("8");
+  adjacency_list<std::string> adj_list;
+
+  for (auto *node: { &n0, &n1, &n2, &n3, &n4, &n5, &n6, &n7, &n8 }) {
+    adj_list.add_vertex(*node);
+  }
+
+  adj_list.add_edge(n0, n1, 4.0);
+  adj_list.add_edge(n0, n7, 8.0);
+  adj_list.add_edge(n1, n2, 8.0);
+  adj_list.add_edge(n1, n7, 11.0);
+  adj_list.add_edge(n2, n8, 2.0);
+  adj_list.add_edge(n7, n8, 7.0);
+  adj_list.add_edge(n6, n8, 6.0);
+  adj_list.add_edge(n6, n7, 1.0);
+  adj_list.add_edge(n2, n3, 7.0);
+  adj_list.add_edge(n2, n5, 4.0);
+  adj_list.add_edge(n6, n5, 2.0);
+  adj_list.add_edge(n3, n5, 14.0);
+  adj_list.add_edge(n3, n4, 9.0);
+  adj_list.add_edge(n4, n5, 10.0);
+
+  graph_snapshot<std::string> snapshot(adj_list);
+  std::vector<vertex_id> sources = { snapshot.get_id(n0),
+                                     snapshot.get_id(n4) };
+
+  distance_matrix batched = multi_source_shortest_paths(snapshot, sources);
+  distance_matrix all_pairs = all_pairs_shortest_paths(
+                                snapshot, execution_policy::parallel(), 2);
+
+  std::cout << "0 -> 4: " << batched(0, snapshot.get_id(n4)) << '\n';
+  assert(batched(0, snapshot.get_id(n4)) == 21.0);
+  assert(batched(1, snapshot.get_id(n8)) == 16.0);
+
+  for (size_t row = 0; row < sources.size(); ++row) {
+    for (vertex_id v = 0; v < snapshot.get_vertex_count(); ++v) {
+      assert(batched(row, v) == all_pairs(sources[row], v));
+    }
+  }
+
+  // unit weights take the bit-parallel BFS path; check it against
+  //  Floyd-Warshall on a random graph with more than 64 sources
+  std::vector<graph_node<int>> nodes;
+  for (int i = 0; i < 150; ++i) {
+    nodes.emplace_back(i);
+  }
+
+  adjacency_list<int> sparse;
+  for (auto& node: nodes) {
+    sparse.add_vertex(node);
+  }
+
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> pick(0, 149);
+  for (int i = 0; i < 250; ++i) {
+    sparse.add_edge(nodes[pick(rng)], nodes[pick(rng)]);
+  }
+
+  graph_snapshot<int> unit(sparse);
+  std::vector<vertex_id> everyone;
+  for (vertex_id v = 0; v < unit.get_vertex_count(); ++v) {
+    everyone.push_back(v);
+  }
+
+  distance_matrix bfs = multi_source_shortest_paths(unit, everyone);
+  distance_matrix fw = all_pairs_shortest_paths(unit,
+                         execution_policy::sequential(), 16);
+
+  for (vertex_id u = 0; u < unit.get_vertex_count(); ++u) {
+    for (vertex_id v = 0; v < unit.get_vertex_count(); ++v) {
+      assert(bfs(u, v) == fw(u, v));
+    }
+  }
+
+  std::cout << "OK\n";
+}
@@ -0,0 +1,69 @@
+#include "adjacency_list.hpp"
+#include "graph_snapshot.hpp"
+#include "vertex_ordering.hpp"
+
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+template <typename T>
+size_t bandwidth(const graph_snapshot<T>& graph)
+{
+  size_t result = 0;
+  for (vertex_id v = 0; v < graph.get_vertex_count(); ++v) {
+    auto neighbours = graph.get_neighbours(v);
+    for (auto it = neighbours.first; it != neighbours.second; ++it) {
+      result = std::max<size_t>(result, (*it > v) ? *it - v : v - *it);
+    }
+  }
+  return result;
+}
+
+int main()
+{
+  // a 20x20 grid, numbered by whatever order the hash map gives
+  std::vector<graph_node<int>> nodes;
+  for (int i = 0; i < 400; ++i) {
+    nodes.emplace_back(i * 7919 % 400);
+  }
+
+  adjacency_list<int> grid;
+  for (auto& node: nodes) {
+    grid.add_vertex(node);
+  }
+  for (int r = 0; r < 20; ++r) {
+    for (int c = 0; c < 20; ++c) {
+      if (c + 1 < 20) {
+        grid.add_edge(nodes[r * 20 + c], nodes[r * 20 + c + 1]);
+      }
+      if (r + 1 < 20) {
+        grid.add_edge(nodes[r * 20 + c], nodes[(r + 1) * 20 + c]);
+      }
+    }
+  }
+
+  graph_snapshot<int> snapshot(grid);
+  vertex_permutation rcm = reverse_cuthill_mckee(snapshot);
+  graph_snapshot<int> reordered = snapshot.get_permuted(rcm.new_to_old);
+
+  std::cout << "bandwidth before: " << bandwidth(snapshot)
+            << ", after RCM: " << bandwidth(reordered) << '\n';
+  assert(bandwidth(reordered) <= 21);
+
+  for (vertex_id v = 0; v < snapshot.get_vertex_count(); ++v) {
+    assert(reordered.get_vertex(rcm.old_to_new[v]) == snapshot.get_vertex(v));
+    assert(reordered.get_id(snapshot.get_vertex(v)) == rcm.old_to_new[v]);
+  }
+
+  vertex_permutation by_degree = degree_ordering(snapshot);
+  assert(snapshot.get_degree(by_degree.new_to_old.front()) == 4);
+  assert(snapshot.get_degree(by_degree.new_to_old.back()) == 2);
+
+  vertex_permutation bfs = bfs_ordering(snapshot);
+  graph_snapshot<int> bfs_graph = snapshot.get_permuted(bfs.new_to_old);
+  std::cout << "bandwidth after BFS: " << bandwidth(bfs_graph) << '\n';
+  assert(bfs_graph.get_arc_count() == snapshot.get_arc_count());
+
+  std::cout << "OK\n";
+}